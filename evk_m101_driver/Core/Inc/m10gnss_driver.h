@@ -1,14 +1,27 @@
 #ifndef __M10_GNSS_DRIVER_H__
 # define __M10_GNSS_DRIVER_H__
 
-#include  "i2c.h"
+#include  "m10gnss_transport.h"
 
-#define I2C_ADDRESS 0x84             // Default address for EVK-M101 module
-#define STREAM_BUFFER_EMPTY 0xFF     // Value returned by stream buffer when empty
-#define STREAM_BUFFER_REGISTER 0xFF  // Address of the stream buffer register
-#define STREAM_BUFFER_REGISTER_SIZE 1  // Address of the stream buffer register
+#define TX_READY_DEFAULT_THRESHOLD 256  // Default number of bytes in the module's buffer to assert TX-ready
+#define TX_READY_DEFAULT_PIO 6           // Default module PIO used as TX-ready output (EXTINT pin on the EVK)
 
-#define STACK_BUFFER_ARRAY_SIZE 400
+#define STREAM_RING_BUFFER_SIZE 2048  // Must be a power of 2
+
+#ifndef STREAM_BUFFER_READ_CHUNK_SIZE
+#define STREAM_BUFFER_READ_CHUNK_SIZE 256  // Max number of bytes per transport read when draining the module's stream buffer
+#endif
+#define STREAM_RING_BUFFER_MASK (STREAM_RING_BUFFER_SIZE - 1)
+#define STREAM_BUFFER_IDLE_BYTE 0xFF  // Sent by the module when it has no data (I2C reads past the byte count)
+#define NMEA_SENTENCE_MAX_SIZE 82     // Max number of characters in an NMEA sentence, `$` and `\r\n` included
+#define UBX_FRAME_MAX_SIZE 784        // Largest UBX frame kept across reads (UBX-NAV-SAT with 64 satellites), longer ones are skipped
+#define UBX_FRAME_SKIP_MAX_SIZE 8192  // Longer UBX frame lengths come from a false sync, which is dropped instead of skipped
+
+#define STREAM_BUFFER_IS_EMPTY(stream_buffer) ((stream_buffer)->head == (stream_buffer)->tail)
+#define STREAM_BUFFER_FREE_SPACE(stream_buffer) ((uint16_t)(((stream_buffer)->tail - (stream_buffer)->head - 1) & STREAM_RING_BUFFER_MASK))
+#define STREAM_BUFFER_PEEK(stream_buffer) ((stream_buffer)->buffer[(stream_buffer)->tail])
+#define STREAM_BUFFER_ADVANCE(stream_buffer) ((stream_buffer)->tail = ((stream_buffer)->tail + 1) & STREAM_RING_BUFFER_MASK)
+#define STREAM_BUFFER_COMMIT(stream_buffer, size) ((stream_buffer)->head = ((stream_buffer)->head + (size)) & STREAM_RING_BUFFER_MASK)
 
 /**
  * @brief Struct to store the number of available satelites for each possible constellation, used
@@ -24,45 +37,139 @@ typedef struct AVAILABLE_SATELITES_TABLE{
     unsigned char GQ;
 } available_satelites_table;
 
+#ifndef GNSS_SATELLITE_TABLE_SIZE
+#define GNSS_SATELLITE_TABLE_SIZE 32  // Max number of satellite signals kept per constellation
+#endif
+#define GNSS_ELEVATION_UNKNOWN INT8_MIN  // Elevation of a satellite whose position is not known
+#define GNSS_AZIMUTH_UNKNOWN 0xFFFF      // Azimuth of a satellite whose position is not known
+
+/**
+ * @brief Constellations reported by `GSV` messages, from their talker (`GP`, `GL`, `GA`, `GB`, `GI` and `GQ`).
+ * 
+ */
+typedef enum GNSS_CONSTELLATION{
+    GPS_CONSTELLATION,
+    GLONASS_CONSTELLATION,
+    GALILEO_CONSTELLATION,
+    BEIDOU_CONSTELLATION,
+    NAVIC_CONSTELLATION,
+    QZSS_CONSTELLATION,
+    NUM_GNSS_CONSTELLATIONS
+} gnss_constellation;
+
+/**
+ * @brief Satellites in view of a constellation, as a struct of arrays (entry `i` of each array describes the same
+ * satellite signal), so a consumer going through a single property (e.g. the SNR of all satellites) reads
+ * contiguous bytes. A satellite tracked on several signals has one entry per signal.
+ * 
+ */
+typedef struct GNSS_SATELLITE_TABLE{
+    uint16_t azimuth[GNSS_SATELLITE_TABLE_SIZE];   // Degrees from the true north, `GNSS_AZIMUTH_UNKNOWN` if not known
+    uint8_t prn[GNSS_SATELLITE_TABLE_SIZE];        // Satellite ID, as numbered in the NMEA messages
+    int8_t elevation[GNSS_SATELLITE_TABLE_SIZE];   // Degrees, `GNSS_ELEVATION_UNKNOWN` if not known
+    uint8_t snr[GNSS_SATELLITE_TABLE_SIZE];        // Carrier to noise ratio (C/N0), in dB-Hz, 0 if not tracked
+    uint8_t signal_id[GNSS_SATELLITE_TABLE_SIZE];  // NMEA signal ID, 0 when the message has none (NMEA 4.0 and older)
+    uint8_t count;                                 // Number of entries
+    uint8_t num_satellites;                        // Number of different satellites among the entries
+    char is_available;                             // Set once a group of messages was completely received
+} gnss_satellite_table;
+
+/**
+ * @brief Mode used to acquire the data in the module's stream buffer.
+ * 
+ */
+typedef enum M10_GNSS_ACQUISITION_MODE{
+    BLOCKING_ACQUISITION,  // Stream buffer read with the transport's blocking `read`
+    DMA_ACQUISITION        // Stream buffer read with the transport's `read_async`, completion signalled by callback
+} m10_gnss_acquisition_mode;
+
+/**
+ * @brief Event that triggers a read of the module's stream buffer.
+ * 
+ */
+typedef enum M10_GNSS_TRIGGER_MODE{
+    POLLING_TRIGGER,    // Stream buffer read on every call to `M10GnssDriverReadData`
+    TX_READY_TRIGGER,   // Stream buffer read only after the module asserts its TX-ready pin
+    IDLE_LINE_TRIGGER   // Stream buffer read only after the transport signals the end of a burst (UART idle line)
+} m10_gnss_trigger_mode;
+
+#define GNSS_NUMERIC_DECIMALS 3   // Decimal digits of the fixed point `gnss_numeric_measurement` value
+#define GNSS_NUMERIC_SCALE 1000    // Units of the fixed point `gnss_numeric_measurement` value per unit (knot, meter, degree...)
+#define GNSS_SECOND_DECIMALS 3     // Decimal digits of the fixed point `utc_date_time` second
+#define GNSS_SECOND_SCALE 1000     // Units of the fixed point `utc_date_time` second per second
+#define GNSS_MS_PER_DAY 86400000UL          // Milliseconds in a day, the range of `M10GnssDriverGetTimeOfDayMs`
+#define GNSS_TIME_OF_DAY_UNKNOWN UINT32_MAX  // Returned by `M10GnssDriverGetTimeOfDayMs` if the time is not available
+
+/**
+ * @brief Representation of the measurements, chosen at build time. By default values are floating point. Defining
+ * `M10_GNSS_FIXED_POINT` (e.g. in the project's preprocessor symbols) makes them scaled integers, so they are decoded,
+ * stored and compared without the soft-float library of the Cortex-M0+:
+ *    - `gnss_numeric_measurement` value: `int32_t`, value x `GNSS_NUMERIC_SCALE` (e.g. 2479 for 2.479 knots);
+ *    - `utc_date_time` second: `uint16_t`, seconds x `GNSS_SECOND_SCALE` (e.g. 45500 for 45.5 s).
+ * 
+ */
+#ifdef M10_GNSS_FIXED_POINT
+typedef int32_t gnss_numeric_value;
+typedef uint16_t gnss_second_value;
+#else
+typedef double gnss_numeric_value;
+typedef float gnss_second_value;
+#endif
+
 /**
  * @brief Base struct for all numerical measurement from the GNSS module, containing 
  * relevant metadata.
  * 
  */
 typedef struct GNSS_NUMERIC_MEASUREMENT{
+    gnss_numeric_value value;  // Last available values (first, so the flags below do not need alignment padding)
     char is_available;         // Check if measurement was available in the last reading
-    double value;              // Last available values
     char unit_of_measurement;  // Engineering Unit of measurement
 }  gnss_numeric_measurement;
 
+/**
+ * @brief Integer measurement from the GNSS module (e.g. number of satellites), containing relevant metadata.
+ * 
+ */
+typedef struct GNSS_INTEGER_MEASUREMENT{
+    char is_available;  // Check if measurement was available in the last reading
+    int value;          // Last available value
+} gnss_integer_measurement;
+
 /**
  * @brief Struct containing UTC data time information, and relevant metadata.
  * 
  */
 typedef struct UTC_DATE_TIME{
+    gnss_second_value second;
     unsigned char year;
     unsigned char month;
     unsigned char day;
     unsigned char hour;
     unsigned char minute;
-    float second;
 
     char is_available;
 } utc_date_time;
 
+#define GNSS_LAT_LONG_SCALE 10000000  // Units of `gnss_lat_long_measurement` value per degree
+
 /**
- * @brief Struct to hold data from both latitude and longitude.
+ * @brief Struct to hold data from both latitude and longitude, as a signed integer number of 1e-7 degrees
+ * (about 1 cm), so it can be decoded and used without floating point.
  * 
  */
 typedef struct GNSS_LAT_LONG_MEASUREMENT{
     char is_available;
-    int degrees;
-    float minutes;
-    char indicator;
+    char indicator;  // `N` / `S` for latitude, `E` / `W` for longitude
+    int32_t value;   // Degrees x GNSS_LAT_LONG_SCALE, negative to the south and to the west
 } gnss_lat_long_measurement;
 
 /**
  * @brief Struct with all the necessary data for the working of the GNSS module as well as its readings.
+ *    The readings (all the members before `transport`) are not written sentence by sentence: the parser assembles
+ * the sentences of a navigation epoch in a staging record, and copies it to the instance at once when the epoch
+ * is complete, incrementing `epoch` and calling `epoch_callback`. Between two calls of the parser, the readings
+ * always come from the same epoch.
  * 
  */
 typedef struct M10_GNSS{
@@ -71,23 +178,139 @@ typedef struct M10_GNSS{
     gnss_lat_long_measurement longitude;
     gnss_numeric_measurement course_over_ground;
     gnss_numeric_measurement speed_over_ground_knots;
+    gnss_numeric_measurement speed_over_ground_kmh;
+    gnss_numeric_measurement altitude;                 // Above mean sea level
+    gnss_numeric_measurement geoid_separation;         // Difference between the ellipsoid and mean sea level
+    gnss_numeric_measurement pdop;                     // Position dilution of precision
+    gnss_numeric_measurement hdop;                     // Horizontal dilution of precision
+    gnss_numeric_measurement vdop;                     // Vertical dilution of precision
+    gnss_integer_measurement fix_quality;              // GGA quality indicator: 0 no fix, 1 autonomous, 2 differential, 6 estimated
+    gnss_integer_measurement fix_type;                 // GSA navigation mode: 1 no fix, 2 2D, 3 3D
+    gnss_integer_measurement satellites_used;          // Number of satellites used in the navigation solution
+    char position_status;                              // `A` for a valid position, `V` otherwise
+    char position_mode;                                // Positioning mode indicator (`N`, `E`, `A`, `D`...)
     utc_date_time time_of_sample;
+    uint32_t epoch;                                    // Number of epochs committed, incremented with each snapshot
     char buffer_empty;
     
-    I2C_HandleTypeDef* i2c_handle;
-    int i2c_address;
+    m10_gnss_transport transport;  // Link to the module, e.g. `M10_GNSS_I2C_TRANSPORT(&hi2c1, I2C_ADDRESS)`
+    m10_gnss_acquisition_mode acquisition_mode;  // `DMA_ACQUISITION` falls back to blocking if the transport has no `read_async`
+
+    m10_gnss_trigger_mode trigger_mode;
+    GPIO_TypeDef* tx_ready_port;   // MCU port connected to the module's TX-ready output
+    uint16_t tx_ready_pin;         // MCU pin connected to the module's TX-ready output
+    uint8_t tx_ready_pio;          // Module PIO used as TX-ready output, TX_READY_DEFAULT_PIO if 0
+    uint16_t tx_ready_threshold;   // Bytes in the module's buffer to assert TX-ready, TX_READY_DEFAULT_THRESHOLD if 0
+    char ubx_output;               // Set to enable the UBX-NAV-PVT, DOP, SAT and EOE messages on the transport's interface
+
+    void (*epoch_callback)(struct M10_GNSS* m10_module);  // Called after each epoch is committed, NULL if not needed
 } m10_gnss;
 
 /**
- * @brief Struct holding the received stream buffer, as well as relevant metadata for data parsing.
+ * @brief Types of NMEA sentences known by the parser, to select the ones to be decoded with `M10_GNSS_SUBSCRIBE`.
+ * 
+ */
+typedef enum M10_GNSS_SENTENCE_TYPE{
+    RMC_SENTENCE,
+    GGA_SENTENCE,
+    VTG_SENTENCE,
+    GSA_SENTENCE,
+    GLL_SENTENCE,
+    GSV_SENTENCE,
+    OTHER_SENTENCE,     // Sentences without a parser, never decoded
+    NUM_SENTENCE_TYPES
+} m10_gnss_sentence_type;
+
+#define M10_GNSS_SUBSCRIBE(sentence_type) ((uint32_t)1 << (sentence_type))
+#define M10_GNSS_ALL_SENTENCES (M10_GNSS_SUBSCRIBE(OTHER_SENTENCE) - 1)
+
+/**
+ * @brief Number of sentence characters (from the `$` to the checksum) that went through the parsers, and that were
+ * skipped because the sentence type is not subscribed (or has no parser).
+ * 
+ */
+typedef struct M10_GNSS_SENTENCE_BYTES{
+    uint32_t decoded;
+    uint32_t skipped;
+} m10_gnss_sentence_bytes;
+
+/**
+ * @brief Number of sentences dropped because of a wrong (or missing) checksum, for each parsed sentence type, and
+ * of UBX frames dropped. The data of a dropped sentence or frame is never written to the `m10_gnss` instance.
+ * 
+ */
+typedef struct M10_GNSS_REJECT_COUNT{
+    uint32_t rmc;
+    uint32_t gga;
+    uint32_t vtg;
+    uint32_t gsa;
+    uint32_t gll;
+    uint32_t gsv;
+    uint32_t ubx;  // UBX frames, with a wrong checksum or an unexpected payload size
+} m10_gnss_reject_count;
+
+/**
+ * @brief Group of `GSV` messages ("message n of m") of a constellation being received. The satellites are added
+ * to the table as each message is received, and only published once the last message of the group arrives.
+ * 
+ */
+typedef struct M10_GNSS_GSV_GROUP{
+    gnss_satellite_table satellites;  // Satellites of the groups received so far in the current cycle
+    uint16_t signals;                 // Signal IDs with a complete group in `satellites`, one bit per ID
+    uint8_t first_entry;              // Entries of `satellites` before the group in progress
+    uint8_t next_message;             // Number of the next message of the group in progress, 0 if none
+    uint8_t num_messages;             // Number of messages of the group in progress
+    uint8_t signal_id;                // Signal ID of the group in progress
+    char is_from_ubx;                 // Set when `satellites` was replaced by UBX-NAV-SAT, until the next GSV group
+} m10_gnss_gsv_group;
+
+/**
+ * @brief Single producer / single consumer ring buffer holding the received stream buffer data.
+ *    The producer (I2C transfer, possibly from the DMA completion interrupt) only writes `head`, and the consumer
+ * (parser, in the main loop) only writes `tail`, so no interrupt masking is needed as long as there is only one
+ * of each.
  * 
  */
 typedef struct M10_GNSS_STREAM_BUFFER{
-    unsigned char buffer[STACK_BUFFER_ARRAY_SIZE];
-    uint16_t buffer_size;
-    int buffer_index;
+    unsigned char buffer[STREAM_RING_BUFFER_SIZE];
+    volatile uint16_t head;  // Index of the next byte to be written, advanced by the producer
+    volatile uint16_t tail;  // Index of the next byte to be parsed, advanced by the consumer
 } m10_gnss_stream_buffer;
 
+/**
+ * @brief Parser context, with all the state needed to parse one stream: the ring buffer it consumes, the 
+ * instance the results are written to and the sentence (or UBX frame) split between two reads. Contexts share nothing, so
+ * several receivers (or several recorded logs, on host threads) can be parsed at the same time.
+ *    The driver has its own context, for the module given to `M10GnssDriverInit`.
+ * 
+ */
+typedef struct M10_GNSS_PARSER{
+    m10_gnss_stream_buffer* stream_buffer;        // Ring buffer the sentences are read from
+    m10_gnss* module;                             // Instance the parsed values are written to
+    char sentence_carry[NMEA_SENTENCE_MAX_SIZE];  // Start of a sentence split by a read boundary (or the end of the ring)
+    uint8_t sentence_carry_length;                // Number of characters in the carry buffer, 0 if no sentence is split
+    uint8_t ubx_carry[UBX_FRAME_MAX_SIZE];        // Start of an UBX frame split by a read boundary (or the end of the ring)
+    uint16_t ubx_carry_length;                    // Bytes of the split UBX frame received (or skipped), 0 if none is split
+    uint16_t ubx_frame_length;                    // Length of the split UBX frame, 0 until its header is complete
+    m10_gnss_reject_count reject_count;           // Sentences dropped because of their checksum
+    uint32_t subscriptions;                       // Sentence types to be decoded, `M10_GNSS_SUBSCRIBE` of each
+    m10_gnss_sentence_bytes sentence_bytes[NUM_SENTENCE_TYPES];  // Characters decoded and skipped, per sentence type
+    m10_gnss_gsv_group gsv_groups[NUM_GNSS_CONSTELLATIONS];       // GSV groups being received, per constellation
+    gnss_satellite_table satellites[NUM_GNSS_CONSTELLATIONS];     // Satellites of the last complete GSV groups
+    m10_gnss epoch_record;                        // Readings of the epoch being received, committed to `module` at once
+    uint32_t epoch_sentences;                     // Sentence types received in the epoch, `M10_GNSS_SUBSCRIBE` of each
+    uint8_t epoch_constellations;                 // Constellations with a GSV group completed in the epoch, one bit each
+    char epoch_pending;                           // Set if the epoch record holds readings not yet committed
+    char epoch_committed;                         // Set once the epoch was committed, its late messages are then dropped
+    uint32_t epoch_key;                           // UTC time of day of the epoch, in milliseconds, `UINT32_MAX` if not known
+    uint8_t epoch_sources;                        // Protocols with messages in the epoch (NMEA, UBX), one bit each
+    uint8_t epoch_sources_ended;                  // Protocols whose last message of the epoch (GLL, UBX-NAV-EOE) was received
+    uint8_t expected_sources;                     // Protocols of the previous epoch, all ending an epoch before it is committed
+    uint32_t ubx_time_of_week;                    // GPS time of week of the last UBX-NAV message, in milliseconds
+    uint32_t ubx_epoch_key;                       // Epoch key of `ubx_time_of_week`, `UINT32_MAX` if not known
+    uint32_t ubx_utc_offset;                      // GPS time of week - UTC time of day, modulo a day, `UINT32_MAX` if not known
+} m10_gnss_parser;
+
 /**
  * @brief Initialize the M10 GNSS Driver.
  * 
@@ -95,15 +318,206 @@ typedef struct M10_GNSS_STREAM_BUFFER{
  */
 void M10GnssDriverInit(m10_gnss* m10_module);
 
+/**
+ * @brief Initialize a parser context, to parse a stream other than the driver's (e.g. a second receiver, or a
+ * recorded log on a host). All the sentence types are subscribed.
+ * 
+ * @param parser: `m10_gnss_parser*` Parser context to be initialized
+ * @param stream_buffer: `m10_gnss_stream_buffer*` Ring buffer the sentences are read from
+ * @param m10_module: `m10_gnss*` Instance the parsed values are written to
+ */
+void M10GnssDriverParserInit(m10_gnss_parser* parser, m10_gnss_stream_buffer* stream_buffer, m10_gnss* m10_module);
+
+/**
+ * @brief Parse all the complete NMEA sentences and UBX frames in the context's ring buffer, keeping a trailing
+ * partial one for the next call. Only accesses the given context, so it can be called for different contexts at
+ * the same time.
+ * 
+ * @param parser: `m10_gnss_parser*` Parser context
+ */
+void M10GnssDriverParseBuffer(m10_gnss_parser* parser);
+
+/**
+ * @brief Parse a complete UBX frame into the context's epoch. The navigation messages `UBX-NAV-PVT` (position,
+ * velocity and time), `UBX-NAV-DOP` and `UBX-NAV-SAT` (satellites in view, into the same tables as `GSV`) are
+ * decoded, the other frames are ignored. The epoch ends on `UBX-NAV-EOE` (end of epoch), and is committed once
+ * the NMEA sentences of the same UTC time (if any) ended too, or as soon as a message of another epoch is received.
+ *    The binary fields are already scaled integers, so a `UBX-NAV-PVT` frame (100 bytes) replaces the `RMC`, `GGA`,
+ * `VTG`, `GSA` and `GLL` sentences without any text conversion.
+ * 
+ * @param parser: `m10_gnss_parser*` Parser context
+ * @param frame: `const uint8_t*` First sync character of the frame, in contiguous memory
+ * @param frame_size: `uint16_t` Number of bytes of the frame, header and checksum included
+ */
+void M10GnssDriverParseUbxFrame(m10_gnss_parser* parser, const uint8_t* frame, uint16_t frame_size);
+
 /**
  * @brief Read and parse the data on the module's stream buffer.
  * 
  */
 void M10GnssDriverReadData(void);
 
+/**
+ * @brief Parse the data already received from the module, without accessing the bus.
+ * 
+ */
+void M10GnssDriverProcessStreamBuffer(void);
+
+/**
+ * @brief Check if a DMA stream buffer transfer (or chain of transfers) is still in progress.
+ * 
+ * @return char: `1` if in progress, `0` otherwise
+ */
+char M10GnssDriverIsTransferInProgress(void);
+
+/**
+ * @brief Check if the parser stopped in the middle of a message, i.e the received data did not end on a
+ * message boundary.
+ * 
+ * @return char: `1` if a message is partially parsed, `0` otherwise
+ */
+char M10GnssDriverIsParsingMessage(void);
+
+/**
+ * @brief Get a numeric measurement as an integer scaled by `GNSS_NUMERIC_SCALE`, whatever the representation. With
+ * `M10_GNSS_FIXED_POINT` it is the stored value, without floating point operations.
+ * 
+ * @param measurement: `const gnss_numeric_measurement*` Measurement
+ * @return int32_t: Value x `GNSS_NUMERIC_SCALE`
+ */
+int32_t M10GnssDriverGetNumericScaled(const gnss_numeric_measurement* measurement);
+
+/**
+ * @brief Get the seconds of a time as an integer scaled by `GNSS_SECOND_SCALE`, whatever the representation. With
+ * `M10_GNSS_FIXED_POINT` it is the stored value, without floating point operations.
+ * 
+ * @param date_time: `const utc_date_time*` Date and time
+ * @return uint16_t: Seconds x `GNSS_SECOND_SCALE`
+ */
+uint16_t M10GnssDriverGetSecondScaled(const utc_date_time* date_time);
+
+/**
+ * @brief Get the UTC time of day of a time in milliseconds, without floating point operations with 
+ * `M10_GNSS_FIXED_POINT`.
+ * 
+ * @param date_time: `const utc_date_time*` Date and time
+ * @return uint32_t: Milliseconds since 00:00:00, `GNSS_TIME_OF_DAY_UNKNOWN` if the time is not available
+ */
+uint32_t M10GnssDriverGetTimeOfDayMs(const utc_date_time* date_time);
+
+#ifdef M10_GNSS_FLOAT_ACCESSORS
+/**
+ * @brief Get a numeric measurement as a double, whatever the representation.
+ * 
+ * @param measurement: `const gnss_numeric_measurement*` Measurement
+ * @return double: Value
+ */
+double M10GnssDriverGetNumeric(const gnss_numeric_measurement* measurement);
+
+/**
+ * @brief Get the seconds of a time as a float, whatever the representation.
+ * 
+ * @param date_time: `const utc_date_time*` Date and time
+ * @return float: Seconds
+ */
+float M10GnssDriverGetSecond(const utc_date_time* date_time);
+
+/**
+ * @brief Get the whole degrees of a latitude or longitude, without its sign, as in the NMEA field.
+ * 
+ * @param lat_long_measurement: `const gnss_lat_long_measurement*` Latitude or longitude
+ * @return int: Degrees
+ */
+int M10GnssDriverGetLatLongDegrees(const gnss_lat_long_measurement* lat_long_measurement);
+
+/**
+ * @brief Get the minutes of a latitude or longitude, without its sign, as in the NMEA field.
+ * 
+ * @param lat_long_measurement: `const gnss_lat_long_measurement*` Latitude or longitude
+ * @return float: Minutes, with a resolution of 1e-6
+ */
+float M10GnssDriverGetLatLongMinutes(const gnss_lat_long_measurement* lat_long_measurement);
+#endif
+
+/**
+ * @brief Get the number of sentences dropped by the parser since initialization.
+ * 
+ * @return const m10_gnss_reject_count*: Pointer to the counters of each sentence type
+ */
+const m10_gnss_reject_count* M10GnssDriverGetRejectCount(void);
+
+/**
+ * @brief Select the sentence types decoded by the driver, the others are skipped as soon as their address field is 
+ * read. All the types are subscribed by `M10GnssDriverInit`.
+ * @code
+ * M10GnssDriverSetSubscriptions(M10_GNSS_SUBSCRIBE(RMC_SENTENCE) | M10_GNSS_SUBSCRIBE(GGA_SENTENCE));
+ * @endcode
+ * 
+ * @param subscriptions: `uint32_t` `M10_GNSS_SUBSCRIBE` of each sentence type to be decoded
+ */
+void M10GnssDriverSetSubscriptions(uint32_t subscriptions);
+
+/**
+ * @brief Get the satellites in view of a constellation, decoded by the driver from the `GSV` messages.
+ *    The table is replaced as a whole with each epoch, with the satellites of the complete groups of messages
+ * ("message n of m", one group per signal ID), so it never holds part of a group. The number of different
+ * satellites is also written to `num_available_satelites` of the `m10_gnss` instance.
+ * 
+ * @param constellation: `gnss_constellation` Constellation
+ * @return const gnss_satellite_table*: Pointer to the satellite table, `is_available` is `0` until the first group
+ */
+const gnss_satellite_table* M10GnssDriverGetSatellites(gnss_constellation constellation);
+
+/**
+ * @brief Get the number of sentence characters decoded and skipped by the driver since initialization.
+ * 
+ * @return const m10_gnss_sentence_bytes*: Array with the counters of each `m10_gnss_sentence_type`
+ */
+const m10_gnss_sentence_bytes* M10GnssDriverGetSentenceBytes(void);
+
 /**
  * @brief Clear the module's stream buffer.
  * 
  */
 void M10GnssDriverClearStreamBuffer(void);
+
+/**
+ * @brief Signal a rising edge on an EXTI line, must be called from `HAL_GPIO_EXTI_Rising_Callback` when 
+ * using `TX_READY_TRIGGER`.
+ * 
+ * @param gpio_pin: `uint16_t` Pin that generated the interrupt
+ */
+void M10GnssDriverExtiCallback(uint16_t gpio_pin);
+
+/**
+ * @brief Signal that the transport received the end of a burst of data (e.g. UART idle line), must be called 
+ * from the transport's event callback (e.g. `M10GnssUartTransportRxEventCallback`) when using `IDLE_LINE_TRIGGER`.
+ * 
+ * @param transport_handle: `void*` Handle of the peripheral that generated the event
+ */
+void M10GnssDriverRxEventCallback(void* transport_handle);
+
+/**
+ * @brief Signal the end of an asynchronous stream buffer read, must be called from the transport's completion 
+ * callback (e.g. `HAL_I2C_MemRxCpltCallback`) when using `DMA_ACQUISITION`.
+ * 
+ * @param transport_handle: `void*` Handle of the peripheral that finished the transfer
+ */
+void M10GnssDriverRxCompleteCallback(void* transport_handle);
+
+/**
+ * @brief Signal a failed asynchronous stream buffer read, must be called from the transport's error callback
+ * (e.g. `HAL_I2C_ErrorCallback`) when using `DMA_ACQUISITION`.
+ * 
+ * @param transport_handle: `void*` Handle of the peripheral that reported the error
+ */
+void M10GnssDriverRxErrorCallback(void* transport_handle);
+
+/**
+ * @brief Signal that the transport dropped received data (e.g. a DMA overrun), must be called from the main loop 
+ * context (e.g. the transport's `bytes_available`). The sentence or UBX frame split before the gap is dropped.
+ * 
+ * @param transport_handle: `void*` Handle of the peripheral that dropped the data
+ */
+void M10GnssDriverRxDataLostCallback(void* transport_handle);
 #endif
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef __M10_GNSS_FILE_TRANSPORT_H__
+#define __M10_GNSS_FILE_TRANSPORT_H__
+
+#include "m10gnss_transport.h"
+
+#ifdef M10_GNSS_HOST_FILE_TRANSPORT
+
+/**
+ * @brief Host side transport reading a recorded log (e.g. the `.ubx` logs in `data`) as if it was the module's stream buffer,
+ * so the acquisition and parsing can be run and benchmarked off target. Only compiled when
+ * `M10_GNSS_HOST_FILE_TRANSPORT` is defined.
+ *    `bytes_available` reports the rest of the file (up to 65535 bytes), so each call to `M10GnssDriverReadData`
+ * reads as much as fits in the ring buffer, and 0 once the end of the file is reached. The log stays open until
+ * `M10GnssFileTransportClose` is called.
+ *
+ * @param file_path: `const char*` Path of the log to be read
+ */
+#define M10_GNSS_FILE_TRANSPORT(file_path) {                                               \
+                                    .interface = FILE_TRANSPORT,                           \
+                                    .handle = (void*)(file_path),                          \
+                                    .open = M10GnssFileTransportOpen,                      \
+                                    .bytes_available = M10GnssFileTransportBytesAvailable, \
+                                    .read = M10GnssFileTransportRead,                      \
+                                    .read_async = NULL,                                    \
+                                    .write = NULL                                          \
+                                }
+
+HAL_StatusTypeDef M10GnssFileTransportOpen(m10_gnss_transport* transport);
+uint16_t M10GnssFileTransportBytesAvailable(m10_gnss_transport* transport);
+HAL_StatusTypeDef M10GnssFileTransportRead(m10_gnss_transport* transport, uint8_t* data, uint16_t data_size);
+
+/**
+ * @brief Close the log opened by `M10GnssDriverInit`, once it is no longer read.
+ *
+ * @param transport: `m10_gnss_transport*` File transport of the driver
+ */
+void M10GnssFileTransportClose(m10_gnss_transport* transport);
+#endif
+#endif
@@ -0,0 +1,70 @@
+#ifndef __M10_GNSS_I2C_TRANSPORT_H__
+#define __M10_GNSS_I2C_TRANSPORT_H__
+
+#include "i2c.h"
+#include "m10gnss_transport.h"
+
+#define I2C_ADDRESS 0x84             // Default address for EVK-M101 module
+#define STREAM_BUFFER_EMPTY 0xFF     // Value returned by stream buffer when empty
+#define STREAM_BUFFER_REGISTER 0xFF  // Address of the stream buffer register
+#define STREAM_BUFFER_REGISTER_SIZE 1  // Address of the stream buffer register
+#define AVAILABLE_BUFFER_HB 0xFD     // Address of the high byte of the stream buffer size
+#define AVAILABLE_BUFFER_LB 0xFE     // Address of the low byte of the stream buffer size
+
+/**
+ * @brief Transport reading the module's stream buffer through its I2C register map, with blocking reads (through
+ * the HAL, or the LL backend with `M10_GNSS_LL_I2C`) and DMA reads (`DMA_ACQUISITION`).
+ *    The completion of the DMA reads must be forwarded from `HAL_I2C_MemRxCpltCallback` and `HAL_I2C_ErrorCallback`
+ * to `M10GnssDriverRxCompleteCallback` and `M10GnssDriverRxErrorCallback`.
+ *
+ * @param i2c_handle: `I2C_HandleTypeDef*` Handle of the I2C peripheral, initialized by `MX_I2Cx_Init`
+ * @param i2c_address: Address of the module, shifted left as in the HAL calls (`I2C_ADDRESS` by default)
+ */
+#define M10_GNSS_I2C_TRANSPORT(i2c_handle, i2c_address) {                                 \
+                                    .interface = I2C_TRANSPORT,                           \
+                                    .handle = (i2c_handle),                               \
+                                    .address = (i2c_address),                             \
+                                    .open = M10GnssI2cTransportOpen,                      \
+                                    .bytes_available = M10GnssI2cTransportBytesAvailable, \
+                                    .read = M10GnssI2cTransportRead,                      \
+                                    .read_async = M10GnssI2cTransportReadAsync,           \
+                                    .write = M10GnssI2cTransportWrite                     \
+                                }
+
+#ifdef M10_GNSS_I2C_CYCLE_COUNT
+/**
+ * @brief CPU cycles spent in the blocking register reads of one kind, measured with SysTick, to compare the HAL
+ * and `M10_GNSS_LL_I2C` backends.
+ *
+ */
+typedef struct M10_GNSS_CYCLE_COUNT{
+    uint32_t last;          // Cycles of the last read
+    uint32_t max;           // Most cycles of a single read
+    uint32_t total;         // Cycles of all reads
+    uint32_t bytes;         // Bytes of all reads
+    uint32_t transactions;  // Number of reads
+} m10_gnss_cycle_count;
+
+/**
+ * @brief Cycle counts of the length register reads (0xFD/0xFE) and the blocking stream buffer reads (0xFF).
+ *
+ */
+typedef struct M10_GNSS_I2C_CYCLE_COUNTS{
+    m10_gnss_cycle_count length_read;
+    m10_gnss_cycle_count stream_read;
+} m10_gnss_i2c_cycle_count;
+
+/**
+ * @brief Get the CPU cycles spent in the blocking register reads since reset.
+ *
+ * @return const m10_gnss_i2c_cycle_count*: Pointer to the cycle counts
+ */
+const m10_gnss_i2c_cycle_count* M10GnssI2cTransportGetCycleCount(void);
+#endif
+
+HAL_StatusTypeDef M10GnssI2cTransportOpen(m10_gnss_transport* transport);
+uint16_t M10GnssI2cTransportBytesAvailable(m10_gnss_transport* transport);
+HAL_StatusTypeDef M10GnssI2cTransportRead(m10_gnss_transport* transport, uint8_t* data, uint16_t data_size);
+HAL_StatusTypeDef M10GnssI2cTransportReadAsync(m10_gnss_transport* transport, uint8_t* data, uint16_t data_size);
+HAL_StatusTypeDef M10GnssI2cTransportWrite(m10_gnss_transport* transport, const uint8_t* data, uint16_t data_size);
+#endif
@@ -0,0 +1,25 @@
+#ifndef __M10_GNSS_LL_I2C_H__
+#define __M10_GNSS_LL_I2C_H__
+
+#include "i2c.h"
+
+#define LL_I2C_TIMEOUT_SPINS 100000  // Max number of flag polls per step before giving up on a transfer
+#define LL_I2C_MAX_RELOAD_SIZE 255   // Max number of bytes per NBYTES reload
+
+/**
+ * @brief Read consecutive registers of an I2C device straight through the peripheral registers, without the HAL
+ * state machine, locking and tick based timeouts. Equivalent to a blocking `HAL_I2C_Mem_Read` with a 1 byte
+ * register address: a write of the register address, a repeated start and a read of `data_size` bytes, reloading
+ * NBYTES every 255 bytes.
+ *    Must not be called while a HAL transfer (e.g. DMA) is in progress on the same peripheral.
+ *
+ * @param i2c: `I2C_TypeDef*` I2C peripheral, already initialized and enabled (e.g. by `MX_I2C1_Init`)
+ * @param device_address: `uint16_t` 7 bit device address, shifted left as in the HAL calls
+ * @param register_address: `uint8_t` Address of the first register to be read
+ * @param data: `uint8_t*` Pointer to hold the read bytes
+ * @param data_size: `uint16_t` Number of bytes to read
+ * @return HAL_StatusTypeDef: `HAL_OK` if the transfer finished, `HAL_ERROR` on NACK, bus error or arbitration
+ * loss, `HAL_TIMEOUT` if a flag was not set in time
+ */
+HAL_StatusTypeDef M10GnssLlI2cMemRead(I2C_TypeDef* i2c, uint16_t device_address, uint8_t register_address, uint8_t* data, uint16_t data_size);
+#endif
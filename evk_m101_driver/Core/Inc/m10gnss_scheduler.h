@@ -0,0 +1,68 @@
+#ifndef __M10_GNSS_SCHEDULER_H__
+#define __M10_GNSS_SCHEDULER_H__
+
+#include "m10gnss_driver.h"
+#include "tim.h"
+
+#define SCHEDULER_LEARNING_POLL_MS 5     // Poll period while learning the module's output phase
+#define SCHEDULER_LEARNING_EPOCHS 4      // Number of consecutive epochs observed before locking
+#define SCHEDULER_BURST_GUARD_MS 20      // Time given to the module to output the whole epoch burst
+#define SCHEDULER_PHASE_STEP_MS 2        // Phase correction applied after a read that came too early
+#define SCHEDULER_PHASE_PROBE_EPOCHS 8   // Number of complete epochs before probing an earlier phase
+#define SCHEDULER_MAX_MISSED_EPOCHS 3    // Number of consecutive missed epochs before learning again
+#define SCHEDULER_MAX_EPOCH_PERIOD_MS 10000
+
+/**
+ * @brief State of the acquisition scheduler.
+ *
+ */
+typedef enum M10_GNSS_SCHEDULER_STATE{
+    SCHEDULER_LEARNING,  // Polling fast to learn the epoch period and the output phase
+    SCHEDULER_LOCKED     // Reading once per epoch, just after the burst is output
+} m10_gnss_scheduler_state;
+
+/**
+ * @brief Struct with the configuration and learned timing of the epoch-phase-locked scheduler.
+ *    All times are in HAL ticks (ms), and the phase is stored as the offset between the HAL tick and the
+ * UTC time of day of the epochs, so it keeps valid across epochs.
+ *
+ */
+typedef struct M10_GNSS_SCHEDULER{
+    m10_gnss* m10_module;
+    TIM_HandleTypeDef* timer_handle;  // One pulse timer with 1 ms ticks, used to trigger the reads
+
+    m10_gnss_scheduler_state state;
+    uint32_t epoch_period_ms;         // Learned navigation epoch period
+    uint32_t epoch_phase_offset_ms;   // HAL tick - UTC time of day at which the epoch is read
+    uint32_t last_utc_ms;             // UTC time of day of the last observed epoch
+    uint8_t observed_epochs;          // Consecutive epochs observed while learning
+    uint8_t complete_epochs;          // Consecutive complete epochs while locked
+    uint8_t missed_epochs;            // Consecutive missed epochs while locked
+
+    volatile char read_pending;       // Set by the timer interrupt
+    char evaluation_pending;          // Read started, waiting for it to finish to evaluate the phase
+} m10_gnss_scheduler;
+
+/**
+ * @brief Initialize the scheduler and start learning the module's output phase.
+ *    The driver must have been initialized with `M10GnssDriverInit` before.
+ *
+ * @param scheduler: `m10_gnss_scheduler*` Pointer to an instance of m10_gnss_scheduler, with `m10_module`
+ * and `timer_handle` set
+ */
+void M10GnssSchedulerInit(m10_gnss_scheduler* scheduler);
+
+/**
+ * @brief Run the scheduler, reading the module when the timer expires. Must be called from the main loop.
+ *
+ */
+void M10GnssSchedulerRun(void);
+
+/**
+ * @brief Signal the expiration of the scheduler's timer, must be called from `HAL_TIM_PeriodElapsedCallback`.
+ *
+ * @param timer_handle: `TIM_HandleTypeDef*` Handle of the timer that expired
+ */
+void M10GnssSchedulerTimerCallback(TIM_HandleTypeDef* timer_handle);
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef __M10_GNSS_TRANSPORT_H__
+#define __M10_GNSS_TRANSPORT_H__
+
+#include "main.h"
+
+/**
+ * @brief Physical link (or source) behind a transport, used where the module needs to be told which of its
+ * interfaces is in use (e.g. the TX-ready configuration).
+ *
+ */
+typedef enum M10_GNSS_TRANSPORT_INTERFACE{
+    I2C_TRANSPORT,
+    UART_TRANSPORT,
+    FILE_TRANSPORT
+} m10_gnss_transport_interface;
+
+struct M10_GNSS_STREAM_BUFFER;  // `m10_gnss_stream_buffer`, defined by the driver
+
+/**
+ * @brief Interface between the driver and the link the module's data comes from, so the same acquisition and
+ * parsing code runs on top of I2C, UART or a recorded log.
+ *    Each implementation provides a `M10_GNSS_..._TRANSPORT(...)` initializer in its own header, to be used
+ * when declaring the `m10_gnss` instance:
+ * @code
+ *       m10_gnss gnss_module = {
+ *           .transport = M10_GNSS_I2C_TRANSPORT(&hi2c1, I2C_ADDRESS),
+ *           ...
+ *       };
+ * @endcode
+ *    All the calls are made from the main loop, except for the completion of `read_async`, which the
+ * implementation signals through `M10GnssDriverRxCompleteCallback` / `M10GnssDriverRxErrorCallback` with
+ * its `handle`.
+ *    A transport whose peripheral writes the data straight into a driver ring buffer (e.g. circular DMA) gives it
+ * as `stream_buffer`. The driver then parses that ring in place: `bytes_available` publishes the received data
+ * into its `head` and `read` is never called.
+ *
+ */
+typedef struct M10_GNSS_TRANSPORT{
+    m10_gnss_transport_interface interface;
+    void* handle;               // Peripheral handle (e.g. I2C_HandleTypeDef*) or path of the file
+    uint16_t address;           // Device address on the bus, if any
+    struct M10_GNSS_STREAM_BUFFER* stream_buffer;  // Ring written by the transport itself and parsed in place, NULL if read
+
+    // Prepare the link, called once by `M10GnssDriverInit`
+    HAL_StatusTypeDef (*open)(struct M10_GNSS_TRANSPORT* transport);
+    // Number of bytes that can be read right now
+    uint16_t (*bytes_available)(struct M10_GNSS_TRANSPORT* transport);
+    // Blocking read of `data_size` bytes, never more than the last `bytes_available`
+    HAL_StatusTypeDef (*read)(struct M10_GNSS_TRANSPORT* transport, uint8_t* data, uint16_t data_size);
+    // Start a read of `data_size` bytes in the background, NULL if not supported
+    HAL_StatusTypeDef (*read_async)(struct M10_GNSS_TRANSPORT* transport, uint8_t* data, uint16_t data_size);
+    // Blocking write of a message to the module (e.g. UBX configuration), NULL if not supported
+    HAL_StatusTypeDef (*write)(struct M10_GNSS_TRANSPORT* transport, const uint8_t* data, uint16_t data_size);
+} m10_gnss_transport;
+#endif
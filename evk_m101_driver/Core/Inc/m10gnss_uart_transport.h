@@ -0,0 +1,99 @@
+#ifndef __M10_GNSS_UART_TRANSPORT_H__
+#define __M10_GNSS_UART_TRANSPORT_H__
+
+#include "usart.h"
+#include "m10gnss_transport.h"
+
+/**
+ * @brief Data lost by the UART reception, since the transport was opened.
+ *
+ */
+typedef struct M10_GNSS_UART_RX_ERRORS{
+    uint32_t overruns;       // Times the unread data was overwritten (DMA lap) or did not fit in the ring
+    uint32_t errors;         // Reception errors reported by the HAL (e.g. framing, noise, UART overrun)
+    uint32_t dropped_bytes;  // Bytes lost to both
+} m10_gnss_uart_rx_errors;
+
+extern struct M10_GNSS_STREAM_BUFFER uart_transport_ring_buffer;
+
+/**
+ * @brief Transport receiving the module's UART output (38400 baud by default) byte by byte in interrupt mode,
+ * into a ring buffer that the driver drains on every read. The module streams continuously on UART, so
+ * `bytes_available` reports what was received since the last read, and there is no `read_async`.
+ *    The reception must be forwarded from `HAL_UART_RxCpltCallback` and `HAL_UART_ErrorCallback` to
+ * `M10GnssUartTransportRxCallback` and `M10GnssUartTransportErrorCallback`.
+ *
+ * @param uart_handle: `UART_HandleTypeDef*` Handle of the UART connected to the module, initialized by `MX_USARTx_UART_Init`
+ */
+#define M10_GNSS_UART_TRANSPORT(uart_handle) {                                             \
+                                    .interface = UART_TRANSPORT,                           \
+                                    .handle = (uart_handle),                               \
+                                    .open = M10GnssUartTransportOpen,                      \
+                                    .bytes_available = M10GnssUartTransportBytesAvailable, \
+                                    .read = M10GnssUartTransportRead,                      \
+                                    .read_async = NULL,                                    \
+                                    .write = M10GnssUartTransportWrite                     \
+                                }
+
+/**
+ * @brief Transport receiving the module's UART output with `HAL_UARTEx_ReceiveToIdle_DMA`, the DMA writing
+ * continuously (circular mode) into the same ring buffer as `M10_GNSS_UART_TRANSPORT`. The CPU is only involved
+ * on the half transfer, transfer complete and idle line events, and the idle line event at the end of each burst
+ * of messages can start the parsing right away with `IDLE_LINE_TRIGGER`.
+ *    The ring is given to the driver as its `stream_buffer`, so the parser reads the DMA buffer in place, without
+ * copying it. A DMA lap over unread data is reported in `M10GnssUartTransportGetRxErrors()`.
+ *    The UART RX must have a DMA channel in circular mode linked to it (`hdmarx`, see `usart.c`), and the reception
+ * must be forwarded from `HAL_UARTEx_RxEventCallback` and `HAL_UART_ErrorCallback` to
+ * `M10GnssUartTransportRxEventCallback` and `M10GnssUartTransportErrorCallback`.
+ *
+ * @param uart_handle: `UART_HandleTypeDef*` Handle of the UART connected to the module, initialized by `MX_USARTx_UART_Init`
+ */
+#define M10_GNSS_UART_DMA_TRANSPORT(uart_handle) {                                            \
+                                    .interface = UART_TRANSPORT,                              \
+                                    .handle = (uart_handle),                                  \
+                                    .stream_buffer = &uart_transport_ring_buffer,             \
+                                    .open = M10GnssUartTransportOpenDma,                      \
+                                    .bytes_available = M10GnssUartTransportBytesAvailableDma, \
+                                    .read = M10GnssUartTransportRead,                         \
+                                    .read_async = NULL,                                       \
+                                    .write = M10GnssUartTransportWrite                        \
+                                }
+
+/**
+ * @brief Store the received byte and restart the reception, must be called from `HAL_UART_RxCpltCallback`.
+ *
+ * @param uart_handle: `UART_HandleTypeDef*` Handle of the UART that received the byte
+ */
+void M10GnssUartTransportRxCallback(UART_HandleTypeDef* uart_handle);
+
+/**
+ * @brief Publish the bytes written by the DMA and signal the driver, must be called from `HAL_UARTEx_RxEventCallback`
+ * when using `M10_GNSS_UART_DMA_TRANSPORT`.
+ *
+ * @param uart_handle: `UART_HandleTypeDef*` Handle of the UART that generated the event
+ * @param size: `uint16_t` Position of the DMA in the ring buffer, as passed to `HAL_UARTEx_RxEventCallback`
+ */
+void M10GnssUartTransportRxEventCallback(UART_HandleTypeDef* uart_handle, uint16_t size);
+
+/**
+ * @brief Restart the reception after an error (e.g. overrun), must be called from `HAL_UART_ErrorCallback`.
+ *
+ * @param uart_handle: `UART_HandleTypeDef*` Handle of the UART that reported the error
+ */
+void M10GnssUartTransportErrorCallback(UART_HandleTypeDef* uart_handle);
+
+/**
+ * @brief Get the count of the data lost by the UART reception, e.g. because the driver was not called often
+ * enough to keep up with the module.
+ *
+ * @return const m10_gnss_uart_rx_errors*: Counters since the transport was opened
+ */
+const m10_gnss_uart_rx_errors* M10GnssUartTransportGetRxErrors(void);
+
+HAL_StatusTypeDef M10GnssUartTransportOpen(m10_gnss_transport* transport);
+uint16_t M10GnssUartTransportBytesAvailable(m10_gnss_transport* transport);
+HAL_StatusTypeDef M10GnssUartTransportOpenDma(m10_gnss_transport* transport);
+uint16_t M10GnssUartTransportBytesAvailableDma(m10_gnss_transport* transport);
+HAL_StatusTypeDef M10GnssUartTransportRead(m10_gnss_transport* transport, uint8_t* data, uint16_t data_size);
+HAL_StatusTypeDef M10GnssUartTransportWrite(m10_gnss_transport* transport, const uint8_t* data, uint16_t data_size);
+#endif
@@ -61,6 +61,9 @@ void Error_Handler(void);
 #define B1_GPIO_Port GPIOC
 #define MCO_Pin GPIO_PIN_0
 #define MCO_GPIO_Port GPIOF
+#define GNSS_TXR_Pin GPIO_PIN_0
+#define GNSS_TXR_GPIO_Port GPIOA
+#define GNSS_TXR_EXTI_IRQn EXTI0_1_IRQn
 #define USART2_TX_Pin GPIO_PIN_2
 #define USART2_TX_GPIO_Port GPIOA
 #define USART2_RX_Pin GPIO_PIN_3
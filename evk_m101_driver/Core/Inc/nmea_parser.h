@@ -25,8 +25,7 @@ typedef unsigned char nmea_caller_id[6];
 typedef enum NMEA_RAW_FIELD_STATUS{
     VALID,           // Valid field with non null data
     EMPTY,           // Filed empty with null data
-    END_OF_MESSAGE,  // Message that ended the message frame
-    PARSING_EN_ROUTE // Parsing occurring but could not be completed due to message slicing
+    END_OF_MESSAGE   // Message that ended the message frame
 }nmea_raw_field_status;
 
 /**
@@ -40,13 +39,84 @@ typedef enum NMEA_LAT_LONG_PARSER{
 }nmea_lat_long_parser;
 
 /**
- * @brief The metadata from the parsing of an NMEA field.
+ * @brief Type of an NMEA field, and of the destination it is decoded to by `NmeaParseSentence`.
  * 
  */
-typedef struct NMEA_RAW_FIELD_METADATA{
-    unsigned char raw_field_length;     // Number of characters in the NMEA field
+typedef enum NMEA_FIELD_TYPE{
+    NMEA_FIELD_TIME,       // `hhmmss.ss` into the time of a `utc_date_time`
+    NMEA_FIELD_DATE,       // `ddmmyy` into the date of a `utc_date_time`
+    NMEA_FIELD_LATITUDE,   // `ddmm.mmmmm` into a `gnss_lat_long_measurement`
+    NMEA_FIELD_LONGITUDE,  // `dddmm.mmmmm` into a `gnss_lat_long_measurement`
+    NMEA_FIELD_HEMISPHERE, // `N`/`S`/`E`/`W` into the `gnss_lat_long_measurement` decoded before, negating it for `S` and `W`
+    NMEA_FIELD_NUMERIC,    // Decimal number into a `gnss_numeric_measurement`
+    NMEA_FIELD_INTEGER,    // Integer number into a `gnss_integer_measurement`
+    NMEA_FIELD_CHAR        // Single character into a `char`, left unchanged if the field is empty
+}nmea_field_type;
+
+/**
+ * @brief Size of the destination of a field type, as a constant expression (e.g. to size a buffer from a schema
+ * at compile time). `NmeaGetFieldSize` gives the same at run time.
+ * 
+ */
+#define NMEA_FIELD_SIZE(type) (((type) == NMEA_FIELD_TIME || (type) == NMEA_FIELD_DATE)? sizeof(utc_date_time) : \
+                               ((type) == NMEA_FIELD_LATITUDE || (type) == NMEA_FIELD_LONGITUDE || \
+                                (type) == NMEA_FIELD_HEMISPHERE)? sizeof(gnss_lat_long_measurement) : \
+                               ((type) == NMEA_FIELD_NUMERIC)? sizeof(gnss_numeric_measurement) : \
+                               ((type) == NMEA_FIELD_INTEGER)? sizeof(gnss_integer_measurement) : sizeof(char))
+
+/**
+ * @brief Description of a field to be decoded from a sentence. The fields not described are skipped.
+ * 
+ */
+typedef struct NMEA_FIELD_DESCRIPTOR{
+    unsigned char index;   // Position of the field in the sentence, 0 being the first after the address field
+    nmea_field_type type;  // Format of the field and of its destination
+    unsigned char length;  // Expected number of characters, 0 for any
+    uint16_t offset;       // Position of the destination in the output struct (`offsetof`)
+}nmea_field_descriptor;
+
+/**
+ * @brief Description of a sentence type, as its field descriptors in increasing `index` order, for example:
+ * @code
+ * const nmea_field_descriptor gll_fields[] = {
+ *     {0, NMEA_FIELD_LATITUDE, 0, offsetof(m10_gnss, latitude)},
+ *     {1, NMEA_FIELD_HEMISPHERE, 1, offsetof(m10_gnss, latitude)},
+ *     ...
+ * };
+ * const nmea_sentence_schema gll_schema = NMEA_SENTENCE_SCHEMA(gll_fields);
+ * @endcode
+ * 
+ */
+typedef struct NMEA_SENTENCE_SCHEMA{
+    const nmea_field_descriptor* fields;
+    unsigned char num_fields;
+}nmea_sentence_schema;
+
+#define NMEA_SENTENCE_SCHEMA(field_descriptors) { .fields = (field_descriptors), .num_fields = sizeof(field_descriptors) / sizeof((field_descriptors)[0]) }
+
+/**
+ * @brief Complete NMEA sentence, contiguous in memory (in the stream buffer, or in the driver's carry buffer when
+ * it was split by a read boundary), from the `$` up to the checksum, without the `\r\n`. The fields are read
+ * in order with `NmeaGetNextField`, starting with the address field (`position` 1), which also accumulates the
+ * checksum of the characters it goes through.
+ * 
+ */
+typedef struct NMEA_SENTENCE{
+    const char* data;        // `$` of the sentence
+    unsigned char length;    // Number of characters in the sentence, at most NMEA_SENTENCE_MAX_SIZE - 2
+    unsigned char position;  // Index of the next character to be tokenized
+    unsigned char checksum;  // XOR of the characters tokenized so far, 0 before the address field
+}nmea_sentence;
+
+/**
+ * @brief View of an NMEA field, pointing into its sentence. The characters are not NUL terminated.
+ * 
+ */
+typedef struct NMEA_FIELD_SPAN{
+    const char* data;                   // First character of the NMEA field
+    unsigned char length;               // Number of characters in the NMEA field
     nmea_raw_field_status field_status; // Status of the field parsing
-}nmea_raw_field_metadata;
+}nmea_field_span;
 
 /**
  * @brief Compare two address fields with the possibility of the `*` wildcard, for example:
@@ -65,52 +135,127 @@ typedef struct NMEA_RAW_FIELD_METADATA{
 char NmeaParserCompareOriginId(nmea_caller_id* message_origin, nmea_caller_id* table_origin);
 
 /**
- * @brief Get the next `,` delimited filed in the NMEA message. If the message was cut (message slicing)
- * due to buffer limitations, the metadata will return `PARSING_EN_ROUTE` for the `nmea_raw_field_status`, 
- * and in the next call it will resume the parsing.
+ * @brief Get the next `,` delimited filed in an NMEA sentence, without copying it. The last field of the sentence
+ * (before the `*` of the checksum) is returned with `END_OF_MESSAGE`.
+ *    The characters of the field and its delimiter are added to the sentence's checksum in the same loop that
+ * looks for the delimiter, so verifying the checksum takes no extra pass over the sentence.
  * 
- * @param stream_buffer: `m10_gnss_stream_buffer*` Pointer to the buffer struct containing both the buffer and
- * necessary metadata for parsing.
- * @param raw_field_buffer: `char (*raw_field_buffer)[NMEA_RAW_BUFFER_SIZE]` Pointer an array of NMEA_RAW_BUFFER_SIZE
- * number of characters, to hold the extracted field's characters.
- * @return nmea_raw_field_metadata: `nmea_raw_field_metadata` Metadata containing parsing results and field length.
+ * @param sentence: `nmea_sentence*` Sentence being parsed, its position is advanced past the field
+ * @return nmea_field_span: `nmea_field_span` View of the field, with the parsing results and field length.
  */
-nmea_raw_field_metadata NmeaGetNextFieldRaw(m10_gnss_stream_buffer* stream_buffer, char (*raw_field_buffer)[NMEA_RAW_BUFFER_SIZE]);
+nmea_field_span NmeaGetNextField(nmea_sentence* sentence);
 
 /**
- * @brief Parse the raw field characters into UTC formatted time.
+ * @brief Check the `*hh` checksum at the end of a sentence against the one accumulated by `NmeaGetNextField`.
+ * The fields the parser did not read are tokenized first, so it can be called at any point after the address
+ * field. Sentences without a checksum are not valid.
+ * 
+ * @param sentence: `nmea_sentence*` Sentence being parsed
+ * @return char: `1` if the checksum matches, `0` otherwise
+ */
+char NmeaIsChecksumValid(nmea_sentence* sentence);
+
+/**
+ * @brief Decode the fields of a sentence described by a schema into an output struct, in a single pass over the
+ * sentence, and verify its checksum. The output is written even if the checksum does not match, so it should be a
+ * copy to be committed only on success.
+ *    An empty field (or one with an unexpected length, or malformed) flags its destination as not available, except
+ * for `NMEA_FIELD_CHAR` destinations, which are left unchanged, and `NMEA_FIELD_DATE` ones, which are left unchanged
+ * when empty and flag the whole `utc_date_time` when malformed. An `NMEA_FIELD_HEMISPHERE` other than `N`, `S`,
+ * `E` or `W` flags its latitude or longitude as not available.
+ * 
+ * @param sentence: `nmea_sentence*` Sentence positioned on its first data field
+ * @param schema: `const nmea_sentence_schema*` Description of the fields to be decoded
+ * @param output: `void*` Struct the descriptor offsets refer to
+ * @return char: `1` if the checksum matches, `0` otherwise
+ */
+char NmeaParseSentence(nmea_sentence* sentence, const nmea_sentence_schema* schema, void* output);
+
+/**
+ * @brief Convert an uppercase hexadecimal digit, as in the checksum or the `GSV` signal ID, to its value.
+ * 
+ * @param character: `char` Hexadecimal digit
+ * @return int: Value, from 0 to 15, `-1` if the character is not a digit
+ */
+int NmeaParseHexDigit(char character);
+
+/**
+ * @brief Get the size of the destination of a field type, e.g. to copy it from a decoded output.
+ * 
+ * @param type: `nmea_field_type` Type of the field
+ * @return unsigned char: Size of the destination, in bytes
+ */
+unsigned char NmeaGetFieldSize(nmea_field_type type);
+
+/**
+ * @brief Parse the raw field characters (`hhmmss` and optional decimals) into UTC formatted time, with the seconds in
+ * the representation of `gnss_second_value`.
  * 
  * @param date_time: `utc_date_time*` Pointer to instance of utc date time to hold final value
- * @param raw_field_buffer: `char (*raw_field_buffer)[NMEA_RAW_BUFFER_SIZE]` Pointer an array of NMEA_RAW_BUFFER_SIZE
- * number of characters, to hold the extracted field's characters.
+ * @param field: `const nmea_field_span*` View of the field's characters
+ * @return char: `1` if the field is a valid time, `0` otherwise (and the time is left unchanged)
  */
-void NmeaParseUtcTime(utc_date_time* date_time, char (*raw_stream_buffer)[NMEA_RAW_BUFFER_SIZE]);
+char NmeaParseUtcTime(utc_date_time* date_time, const nmea_field_span* field);
 
 /**
- * @brief Parse the raw field characters into UTC formatted date.
+ * @brief Parse the raw field characters (`ddmmyy`) into UTC formatted date.
  * 
  * @param date_time: `utc_date_time*` Pointer to instance of utc date time to hold final value
- * @param raw_field_buffer: `char (*raw_field_buffer)[NMEA_RAW_BUFFER_SIZE]` Pointer an array of NMEA_RAW_BUFFER_SIZE
- * number of characters, to hold the extracted field's characters.
+ * @param field: `const nmea_field_span*` View of the field's characters
+ * @return char: `1` if the field is a valid date, `0` otherwise (and the date is left unchanged)
  */
-void NmeaParseUtcDate(utc_date_time* date_time, char (*raw_stream_buffer)[NMEA_RAW_BUFFER_SIZE]);
+char NmeaParseUtcDate(utc_date_time* date_time, const nmea_field_span* field);
 
 /**
- * @brief Parse the raw field characters into latitude or longitude format.
+ * @brief Parse the raw field characters into latitude or longitude format, in 1e-7 degrees, with integer
+ * operations only. The minutes can have any number of decimal digits (or none), only the first 6 are used, and
+ * must be below 60.
+ * The value is positive, the sign comes from the indicator field (see `NMEA_FIELD_HEMISPHERE`).
  * 
  * @param lat_long_measurement: `gnss_lat_long_measurement*` Pointer to the instance of lat_long_measurement to hold final value
- * @param raw_field_buffer: `char (*raw_field_buffer)[NMEA_RAW_BUFFER_SIZE]` Pointer an array of NMEA_RAW_BUFFER_SIZE
- * number of characters, to hold the extracted field's characters.
+ * @param field: `const nmea_field_span*` View of the field's characters
  * @param nmea_parser_option: `nmea_lat_long_parser` Specify rather to parse data as a latitude field or longitude field
+ * @return char: `1` if the field is well formed, `0` otherwise (and the value is left unchanged)
+ */
+char NmeaParseLatLong(gnss_lat_long_measurement* lat_long_measurement, const nmea_field_span* field, nmea_lat_long_parser nmea_parser_option);
+
+/**
+ * @brief Parse and convert field data to an integer, with an optional `-` sign.
+ * 
+ * @param field: `const nmea_field_span*` View of the field's characters
+ * @param value: `int*` Pointer to the converted value, left unchanged on failure
+ * @return char: `1` on success, `0` if the field is empty, has a character other than a digit or does not fit an `int32_t`
+ */
+char NmeaParseInteger(const nmea_field_span* field, int* value);
+
+/**
+ * @brief Parse a decimal field (optional `-`, digits, optional `.` and decimal digits) into a scaled integer, with
+ * integer operations only, e.g. speed in knots x 1000 with `decimals = 3`. Extra decimal digits are rounded half
+ * away from zero, missing ones are taken as zeros.
+ * 
+ * @param field: `const nmea_field_span*` View of the field's characters
+ * @param decimals: `unsigned char` Number of decimal digits of the result (the value is scaled by 10^decimals)
+ * @param value: `int32_t*` Pointer to the scaled value, left unchanged on failure
+ * @return char: `1` on success, `0` if the field is empty, malformed or the scaled value does not fit an `int32_t`
+ */
+char NmeaParseDecimal(const nmea_field_span* field, unsigned char decimals, int32_t* value);
+
+/**
+ * @brief Parse a decimal field into a double, through `NmeaParseDecimal` and a single division. All the decimal
+ * digits that fit in 9 significant digits are kept, which rounds like `atof` on the fields sent by the module, and
+ * longer fields are rounded to 9 significant digits (or to an integer, for integer parts of 10 digits).
+ * 
+ * @param field: `const nmea_field_span*` View of the field's characters
+ * @param value: `double*` Pointer to the converted value, left unchanged on failure
+ * @return char: `1` on success, `0` if the field is empty, malformed or out of the `int32_t` range
  */
-void NmeaParseLatLong(gnss_lat_long_measurement* lat_long_measurement, char (*raw_stream_buffer)[NMEA_RAW_BUFFER_SIZE], nmea_lat_long_parser nmea_parser_option);
+char NmeaParseDouble(const nmea_field_span* field, double* value);
 
 /**
  * @brief Parse and convert field data to double. 
  * 
- * @param raw_field_buffer: `char (*raw_field_buffer)[NMEA_RAW_BUFFER_SIZE]` Pointer an array of NMEA_RAW_BUFFER_SIZE
- * number of characters, to hold the extracted field's characters.
- * @return double: Converted value
+ * @param field: `const nmea_field_span*` View of the field's characters
+ * @return double: Converted value, `0.0` if the field is empty, malformed or out of range (as with `atof`)
  */
-double NmeaParseNumericFloatingPoint(char (*raw_stream_buffer)[NMEA_RAW_BUFFER_SIZE]);
+double NmeaParseNumericFloatingPoint(const nmea_field_span* field);
 #endif
\ No newline at end of file
@@ -0,0 +1,123 @@
+#ifndef __UBX_PARSER_H__
+#define __UBX_PARSER_H__
+
+#include "m10gnss_driver.h"
+
+#define UBX_SYNC_CHAR_1 0xB5
+#define UBX_SYNC_CHAR_2 0x62
+#define UBX_HEADER_SIZE 6    // Sync characters, class, id and length
+#define UBX_CHECKSUM_SIZE 2  // CK_A and CK_B
+#define UBX_FRAME_OVERHEAD (UBX_HEADER_SIZE + UBX_CHECKSUM_SIZE)
+
+#define UBX_CLASS_NAV 0x01
+#define UBX_ID_NAV_DOP 0x04
+#define UBX_ID_NAV_PVT 0x07
+#define UBX_ID_NAV_SAT 0x35
+#define UBX_ID_NAV_EOE 0x61  // End of epoch
+
+#define UBX_NAV_PVT_PAYLOAD_SIZE 92
+#define UBX_NAV_DOP_PAYLOAD_SIZE 18
+#define UBX_NAV_SAT_HEADER_SIZE 8      // Payload bytes before the first satellite
+#define UBX_NAV_SAT_SATELLITE_SIZE 12  // Payload bytes of each satellite
+
+// Little endian fields of a payload, read a byte at a time (the Cortex-M0+ has no unaligned loads)
+#define UBX_U1(payload, offset) ((uint8_t)(payload)[offset])
+#define UBX_I1(payload, offset) ((int8_t)(payload)[offset])
+#define UBX_U2(payload, offset) ((uint16_t)((payload)[offset] | ((uint16_t)(payload)[(offset) + 1] << 8)))
+#define UBX_I2(payload, offset) ((int16_t)UBX_U2(payload, offset))
+#define UBX_U4(payload, offset) ((uint32_t)UBX_U2(payload, offset) | ((uint32_t)UBX_U2(payload, (offset) + 2) << 16))
+#define UBX_I4(payload, offset) ((int32_t)UBX_U4(payload, offset))
+
+/**
+ * @brief View of a complete UBX frame, from its sync characters to its checksum, wherever it is stored (ring
+ * buffer or carry buffer).
+ *    Frame structure: `0xB5 0x62 | class | id | length (U2) | payload (length bytes) | CK_A | CK_B`
+ *
+ */
+typedef struct UBX_FRAME{
+    const uint8_t* data;  // First sync character
+    uint16_t length;      // Number of bytes of the frame, header and checksum included
+} ubx_frame;
+
+#define UBX_FRAME_CLASS(frame) ((frame)->data[2])
+#define UBX_FRAME_ID(frame) ((frame)->data[3])
+#define UBX_FRAME_PAYLOAD(frame) (&(frame)->data[UBX_HEADER_SIZE])
+#define UBX_FRAME_PAYLOAD_SIZE(frame) UBX_U2((frame)->data, 4)
+
+/**
+ * @brief Compute the 8-bit Fletcher checksum of an UBX frame, over the class, id, length and payload fields.
+ *
+ * @param data: `const uint8_t*` Pointer to the first byte to be included (the message class)
+ * @param data_size: `uint16_t` Number of bytes to be included
+ * @param checksum: `uint8_t*` Pointer to 2 bytes to hold CK_A and CK_B
+ */
+void UbxChecksum(const uint8_t* data, uint16_t data_size, uint8_t* checksum);
+
+/**
+ * @brief Get the size of a whole frame from its header, to know how many bytes to wait for (or skip).
+ *
+ * @param header: `const uint8_t*` First `UBX_HEADER_SIZE` bytes of the frame
+ * @return uint16_t: Number of bytes of the frame, header and checksum included
+ */
+uint16_t UbxGetFrameLength(const uint8_t* header);
+
+/**
+ * @brief Check the sync characters, the length and the checksum of a frame.
+ *
+ * @param frame: `const ubx_frame*` Frame
+ * @return char: `1` if the frame is valid, `0` otherwise
+ */
+char UbxIsFrameValid(const ubx_frame* frame);
+
+/**
+ * @brief Get the GPS time of week of a navigation (`UBX-NAV`) message, the same for all the messages of an epoch.
+ *
+ * @param frame: `const ubx_frame*` Valid `UBX-NAV` frame, with at least 4 bytes of payload
+ * @return uint32_t: Time of week, in milliseconds
+ */
+uint32_t UbxGetTimeOfWeek(const ubx_frame* frame);
+
+/**
+ * @brief Get the UTC time of day of an `UBX-NAV-PVT` message, with the seconds rounded to the millisecond as in
+ * the decoded time, without decoding the rest of the message.
+ *
+ * @param frame: `const ubx_frame*` Valid `UBX-NAV` frame
+ * @param time_of_day: `uint32_t*` Milliseconds since 00:00:00 UTC, left unchanged on failure
+ * @return char: `1` on success, `0` if the frame is not an `UBX-NAV-PVT` or its UTC time is not valid
+ */
+char UbxGetUtcTimeOfDay(const ubx_frame* frame, uint32_t* time_of_day);
+
+/**
+ * @brief Decode an `UBX-NAV-PVT` message (position, velocity and time solution) into the readings of a module
+ * instance: time and date, latitude and longitude (already in 1e-7 degrees), altitude, geoid separation, speed
+ * and course over ground, PDOP, fix quality and type, satellites used, position status and mode. The values are
+ * converted to the representation of the build (see `M10_GNSS_FIXED_POINT`) with integer operations in a fixed
+ * point build.
+ *
+ * @param frame: `const ubx_frame*` Valid `UBX-NAV-PVT` frame
+ * @param output: `m10_gnss*` Instance the readings are written to
+ * @return char: `1` on success, `0` if the payload does not have the expected size (and nothing is written)
+ */
+char UbxParseNavPvt(const ubx_frame* frame, m10_gnss* output);
+
+/**
+ * @brief Decode an `UBX-NAV-DOP` message into the PDOP, HDOP and VDOP of a module instance.
+ *
+ * @param frame: `const ubx_frame*` Valid `UBX-NAV-DOP` frame
+ * @param output: `m10_gnss*` Instance the readings are written to
+ * @return char: `1` on success, `0` if the payload does not have the expected size (and nothing is written)
+ */
+char UbxParseNavDop(const ubx_frame* frame, m10_gnss* output);
+
+/**
+ * @brief Decode the satellites of a constellation from an `UBX-NAV-SAT` message, which holds the satellites of
+ * all the constellations. The satellite IDs are converted to the NMEA numbering (e.g. 65 to 96 for GLONASS, 33 to
+ * 64 for SBAS, reported with GPS), so the table is the same as the one decoded from `GSV`, with a signal ID of 0.
+ *
+ * @param frame: `const ubx_frame*` Valid `UBX-NAV-SAT` frame
+ * @param constellation: `gnss_constellation` Constellation to be decoded
+ * @param table: `gnss_satellite_table*` Table to be filled
+ * @return char: `1` on success, `0` if the payload size does not match its number of satellites (and nothing is written)
+ */
+char UbxParseNavSat(const ubx_frame* frame, gnss_constellation constellation, gnss_satellite_table* table);
+#endif
@@ -1,32 +1,65 @@
 #include "m10gnss_driver.h"
+#include "m10gnss_i2c_transport.h"
+#include "m10gnss_uart_transport.h"
+#include "m10gnss_scheduler.h"
 #include "application.h"
 #include "gpio.h"
-// #include "tim.h"
+#include "tim.h"
 #include "i2c.h"
+#include "usart.h"
 
-#define SAMPLING_TIM htim6
 m10_gnss gnss_module = {
-                            .i2c_address = I2C_ADDRESS,
-                            .i2c_handle = &hi2c1
+                            .transport = M10_GNSS_I2C_TRANSPORT(&hi2c1, I2C_ADDRESS),
+                            .acquisition_mode = DMA_ACQUISITION,
+                            .trigger_mode = TX_READY_TRIGGER,
+                            .tx_ready_port = GNSS_TXR_GPIO_Port,
+                            .tx_ready_pin = GNSS_TXR_Pin
                         };
 
+m10_gnss_scheduler gnss_scheduler = {
+                                        .m10_module = &gnss_module,
+                                        .timer_handle = &htim6
+                                    };
+
 
 void ApplicationMain(void){
 
     M10GnssDriverInit(&gnss_module);
-    // HAL_TIM_Base_Start_IT(&SAMPLING_TIM);
+    M10GnssSchedulerInit(&gnss_scheduler);
 
     while (1)
     {
-        M10GnssDriverReadData();
+        M10GnssSchedulerRun();
         if(gnss_module.latitude.is_available)
             HAL_GPIO_TogglePin(LED_GREEN_GPIO_Port, LED_GREEN_Pin);
 
-        HAL_Delay(100);
+        // Sleep until the next interrupt (TIM6, TX-ready, DMA or SysTick), reads are only started by TIM6
+        __WFI();
     }
     
 }
 
-// void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim) {
-//     stat = 1;
-// }
\ No newline at end of file
+void HAL_GPIO_EXTI_Rising_Callback(uint16_t GPIO_Pin){
+    M10GnssDriverExtiCallback(GPIO_Pin);
+}
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c){
+    M10GnssDriverRxCompleteCallback(hi2c);
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c){
+    M10GnssDriverRxErrorCallback(hi2c);
+}
+
+// USART2 events, only handled by the transport once `gnss_module` uses M10_GNSS_UART_DMA_TRANSPORT(&huart2)
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size){
+    M10GnssUartTransportRxEventCallback(huart, Size);
+}
+
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart){
+    M10GnssUartTransportErrorCallback(huart);
+}
+
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim){
+    M10GnssSchedulerTimerCallback(htim);
+}
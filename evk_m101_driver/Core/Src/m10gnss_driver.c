@@ -1,74 +1,447 @@
-#include "i2c.h"
 #include "m10gnss_driver.h"
 #include "nmea_parser.h"
-
-#define AVAILABLE_BUFFER_HB 0xFD
-#define AVAILABLE_BUFFER_LB 0xFE
+#include "nmea_scan.h"
+#include "ubx_parser.h"
+#include <stddef.h>
+#include <string.h>
+
+#define UBX_CLASS_CFG 0x06
+#define UBX_ID_CFG_VALSET 0x8A
+#define UBX_CFG_LAYER_RAM 0x01
+
+#define CFG_TXREADY_ENABLED 0x10A20001    // L  - Enable the TX-ready output
+#define CFG_TXREADY_POLARITY 0x10A20002   // L  - 0 for active high
+#define CFG_TXREADY_PIN 0x20A20003        // U1 - Module PIO used as output
+#define CFG_TXREADY_THRESHOLD 0x30A20004  // U2 - Threshold, in units of 8 bytes
+#define CFG_TXREADY_INTERFACE 0x20A20005  // E1 - 0 for I2C, 1 for SPI
+#define CFG_TXREADY_INTERFACE_I2C 0
+#define TX_READY_THRESHOLD_UNIT 8
+
+#define UBX_CFG_TXREADY_FRAME_SIZE 38     // 6 (header) + 30 (payload) + 2 (checksum)
+
+#define CFG_MSGOUT_UBX_NAV_PVT 0x20910006  // U1 - UBX-NAV-PVT output rate on I2C, in epochs
+#define CFG_MSGOUT_UBX_NAV_DOP 0x20910038  // U1 - UBX-NAV-DOP output rate on I2C, in epochs
+#define CFG_MSGOUT_UBX_NAV_SAT 0x20910015  // U1 - UBX-NAV-SAT output rate on I2C, in epochs
+#define CFG_MSGOUT_UBX_NAV_EOE 0x2091015F  // U1 - UBX-NAV-EOE output rate on I2C, in epochs
+#define CFG_MSGOUT_UART1_OFFSET 1          // Offset from the I2C key of a message to its UART1 key
+
+#define UBX_CFG_UBX_OUTPUT_FRAME_SIZE 32  // 6 (header) + 24 (payload) + 2 (checksum)
+
+#define M10_GNSS_READINGS_SIZE offsetof(m10_gnss, transport)  // Readings of `m10_gnss`, committed once per epoch
+#define EPOCH_LAST_SENTENCE GLL_SENTENCE                        // Last sentence of an epoch, in the module's output order
+#define EPOCH_SINGLE_SENTENCES (M10_GNSS_SUBSCRIBE(RMC_SENTENCE) | M10_GNSS_SUBSCRIBE(GGA_SENTENCE) | \
+                                M10_GNSS_SUBSCRIBE(VTG_SENTENCE) | M10_GNSS_SUBSCRIBE(GLL_SENTENCE))  // Sent once per epoch
+#define EPOCH_KEY_UNKNOWN GNSS_TIME_OF_DAY_UNKNOWN  // Epoch key (UTC time of day in ms) of an epoch whose time is not known yet
+#define EPOCH_SOURCE_NMEA 0x01
+#define EPOCH_SOURCE_UBX 0x02
+#define SCHEMA_DESCRIPTOR(index, type, length, destination) {index, type, length, offsetof(m10_gnss, destination)},
+#define SCHEMA_FIELD_SIZE(index, type, length, destination) + NMEA_FIELD_SIZE(type)
+#define SCHEMA_SAVE_SIZE(fields) (0 fields(SCHEMA_FIELD_SIZE))  // Bytes saved for a schema, at most
+#define SCHEMA_SAVE_AREA_SIZE SCHEMA_SAVE_SIZE(NMEA_GGA_FIELDS)  // GGA writes the most measurements
+
+#define GSV_SATELLITES_PER_MESSAGE 4
+#define GSV_SATELLITE_FIELDS 4  // ID, elevation, azimuth and SNR
 
 #define MESSAGE_START '$'
-#define NUM_PARSING_TABLE_ENTRIES 2
+#define MESSAGE_END '\n'
+#define NMEA_TALKER_SIZE 2
+#define NMEA_FORMATTER_SIZE 3
+
+/**
+ * @internal
+ * @brief Sentence formatter (type of message) packed in an integer, to be used as a `switch` case.
+ * 
+ * @endinternal
+ */
+#define NMEA_FORMATTER_KEY(formatter_1, formatter_2, formatter_3) \
+            (((uint32_t)(uint8_t)(formatter_1) << 16) | ((uint32_t)(uint8_t)(formatter_2) << 8) | (uint32_t)(uint8_t)(formatter_3))
+
+/**
+ * @internal
+ * @brief Compare the talker (constellation) of an address field with the talker of a parsing table entry, where
+ * `*` matches any character. The entry's characters are constants, so the wildcards are resolved at compile time.
+ * 
+ * @endinternal
+ */
+#define NMEA_TALKER_MATCHES(address, talker_1, talker_2) \
+            (((talker_1) == '*' || (address)[0] == (talker_1)) && ((talker_2) == '*' || (address)[1] == (talker_2)))
 
 /**
  * @internal
- * @brief Entry for a caller lookup table, which relates the constellation that
- * generated the message and type of message (called `nmea_caller_id`) and the 
- * callback to parse the message in the NMEA format.
- *    The `nmea_caller_id` supports wildcard  `*` for characters that do not matter 
- *  for message -> parsing function matching, for example: 
+ * @brief Parsing table, which relates the constellation that generated the message (talker) and the type of
+ * message (formatter) to its `m10_gnss_sentence_type` and to the way it is parsed: `NMEA_SCHEMA` entries are
+ * decoded by `NmeaParseSentence` from their `nmea_sentence_schema`, counting the rejected sentences in the given
+ * `m10_gnss_reject_count` member, and `NMEA_PARSER` entries are handed to their own parsing function.
+ *    The talker supports wildcard `*` for characters that do not matter for message -> parsing function
+ * matching, for example: 
  * @code
- *       `... = {
- *        {...},
- *        {
- *         .message_origin = "**GSV",
- *         .parser_function = M10GnssDriverGsvParser
- *        }`
- *    
+ *       NMEA_PARSER('*', '*', 'G', 'S', 'V', M10GnssDriverGsvParser)
  * @endcode
  *    In the above example, it does not matter the constellation of origin, all `GSV` messages would be parsed 
  * by corresponding parsing function `M10GnssDriverGsvParser`.
+ *    The table is expanded into the cases of a `switch` on `NMEA_FORMATTER_KEY` (see `M10GnssDriverNmeaMessageDelegator`),
+ * so the dispatch cost does not depend on the number of entries. Because of that, each formatter can only have one
+ * entry (a duplicate is a compile error), and the formatter characters cannot be wildcards.
  *    For more information about possible constellations and all the message types supported by NMEA, check:
  * https://content.u-blox.com/sites/default/files/u-blox-M10-SPG-5.10_InterfaceDescription_UBX-21035062.pdf
  *
  * @endinternal
  */
-typedef struct NMEA_MESSAGE_PARSING_TABLE_ENTRY{
-    nmea_caller_id message_origin;              // Constellation + message type, with possible `*` wild card
-    void(*parser_function)(nmea_caller_id*) ;   // Callback to parse the message
-} nmea_message_parsing_table_entry;
+#define NMEA_PARSING_TABLE(NMEA_SCHEMA, NMEA_PARSER)                                    \
+            NMEA_SCHEMA('G', 'N', 'R', 'M', 'C', RMC_SENTENCE, nmea_rmc_schema, rmc)     \
+            NMEA_SCHEMA('G', 'N', 'G', 'G', 'A', GGA_SENTENCE, nmea_gga_schema, gga)     \
+            NMEA_SCHEMA('G', 'N', 'V', 'T', 'G', VTG_SENTENCE, nmea_vtg_schema, vtg)     \
+            NMEA_SCHEMA('G', 'N', 'G', 'S', 'A', GSA_SENTENCE, nmea_gsa_schema, gsa)     \
+            NMEA_SCHEMA('G', 'N', 'G', 'L', 'L', GLL_SENTENCE, nmea_gll_schema, gll)     \
+            NMEA_PARSER('*', '*', 'G', 'S', 'V', GSV_SENTENCE, M10GnssDriverGsvParser)
+
+/**
+ * @internal
+ * @brief State of the DMA stream buffer transfer, updated from the transport callbacks when using
+ * `DMA_ACQUISITION`.
+ * 
+ * @endinternal
+ */
+typedef enum STREAM_TRANSFER_STATE{
+    TRANSFER_IDLE,
+    TRANSFER_IN_PROGRESS
+} stream_transfer_state;
+
+/**
+ * @internal
+ * @brief Satellite decoded from a `GSV` message, before the message checksum is verified.
+ * 
+ * @endinternal
+ */
+typedef struct GSV_SATELLITE{
+    uint16_t azimuth;
+    uint8_t prn;
+    int8_t elevation;
+    uint8_t snr;
+} gsv_satellite;
+
+void M10GnssDriverGsvParser(m10_gnss_parser* parser, nmea_caller_id* nmea_origin_id, nmea_sentence* sentence);
+
+/**
+ * @internal
+ * @brief Position of each constellation's counter in `available_satelites_table`.
+ * 
+ * @endinternal
+ */
+const unsigned char available_satelites_offsets[NUM_GNSS_CONSTELLATIONS] = {
+    [GPS_CONSTELLATION] = offsetof(available_satelites_table, GP),
+    [GLONASS_CONSTELLATION] = offsetof(available_satelites_table, GL),
+    [GALILEO_CONSTELLATION] = offsetof(available_satelites_table, GA),
+    [BEIDOU_CONSTELLATION] = offsetof(available_satelites_table, GB),
+    [NAVIC_CONSTELLATION] = offsetof(available_satelites_table, GI),
+    [QZSS_CONSTELLATION] = offsetof(available_satelites_table, GQ)
+};
 
 /**
  * @internal
- * @brief State of the parser, used when message slicing happens (i.e a message is broken due to buffer size
- * limitations).
+ * @brief Position of the `is_available` flag of each measurement in `m10_gnss`, cleared when an epoch starts so a
+ * measurement missing from the epoch is not committed with the value of an earlier one.
  * 
  * @endinternal
  */
-typedef enum PARSER_STATE{
-    IDLE,
-    PARSING, 
-    DISCARDING_MESSAGE
-} parser_state;
+const unsigned char epoch_availability_offsets[] = {
+    offsetof(m10_gnss, latitude.is_available),
+    offsetof(m10_gnss, longitude.is_available),
+    offsetof(m10_gnss, course_over_ground.is_available),
+    offsetof(m10_gnss, speed_over_ground_knots.is_available),
+    offsetof(m10_gnss, speed_over_ground_kmh.is_available),
+    offsetof(m10_gnss, altitude.is_available),
+    offsetof(m10_gnss, geoid_separation.is_available),
+    offsetof(m10_gnss, pdop.is_available),
+    offsetof(m10_gnss, hdop.is_available),
+    offsetof(m10_gnss, vdop.is_available),
+    offsetof(m10_gnss, fix_quality.is_available),
+    offsetof(m10_gnss, fix_type.is_available),
+    offsetof(m10_gnss, satellites_used.is_available),
+    offsetof(m10_gnss, time_of_sample.is_available)
+};
+
+/**
+ * @internal
+ * @brief Schemas of the sentences decoded by `NmeaParseSentence`, as described in the user's manual:
+ * https://content.u-blox.com/sites/default/files/u-blox-M10-SPG-5.10_InterfaceDescription_UBX-21035062.pdf
+ *    Each schema is listed once as `FIELD(index, type, length, destination)` entries, from which both its descriptors
+ * and the size of its save area (`SCHEMA_SAVE_SIZE`) are built.
+ * 
+ * @endinternal
+ */
+#define NMEA_RMC_FIELDS(FIELD) \
+    FIELD(0, NMEA_FIELD_TIME, 9, time_of_sample) \
+    FIELD(1, NMEA_FIELD_CHAR, 1, position_status) \
+    FIELD(2, NMEA_FIELD_LATITUDE, 0, latitude) \
+    FIELD(3, NMEA_FIELD_HEMISPHERE, 1, latitude) \
+    FIELD(4, NMEA_FIELD_LONGITUDE, 0, longitude) \
+    FIELD(5, NMEA_FIELD_HEMISPHERE, 1, longitude) \
+    FIELD(6, NMEA_FIELD_NUMERIC, 0, speed_over_ground_knots) \
+    FIELD(7, NMEA_FIELD_NUMERIC, 0, course_over_ground) \
+    FIELD(8, NMEA_FIELD_DATE, 6, time_of_sample) \
+    FIELD(11, NMEA_FIELD_CHAR, 1, position_mode)
+
+const nmea_field_descriptor nmea_rmc_fields[] = { NMEA_RMC_FIELDS(SCHEMA_DESCRIPTOR) };
+
+#define NMEA_GGA_FIELDS(FIELD) \
+    FIELD(0, NMEA_FIELD_TIME, 9, time_of_sample) \
+    FIELD(1, NMEA_FIELD_LATITUDE, 0, latitude) \
+    FIELD(2, NMEA_FIELD_HEMISPHERE, 1, latitude) \
+    FIELD(3, NMEA_FIELD_LONGITUDE, 0, longitude) \
+    FIELD(4, NMEA_FIELD_HEMISPHERE, 1, longitude) \
+    FIELD(5, NMEA_FIELD_INTEGER, 1, fix_quality) \
+    FIELD(6, NMEA_FIELD_INTEGER, 0, satellites_used) \
+    FIELD(7, NMEA_FIELD_NUMERIC, 0, hdop) \
+    FIELD(8, NMEA_FIELD_NUMERIC, 0, altitude) \
+    FIELD(9, NMEA_FIELD_CHAR, 1, altitude.unit_of_measurement) \
+    FIELD(10, NMEA_FIELD_NUMERIC, 0, geoid_separation) \
+    FIELD(11, NMEA_FIELD_CHAR, 1, geoid_separation.unit_of_measurement)
+
+const nmea_field_descriptor nmea_gga_fields[] = { NMEA_GGA_FIELDS(SCHEMA_DESCRIPTOR) };
+
+#define NMEA_VTG_FIELDS(FIELD) \
+    FIELD(0, NMEA_FIELD_NUMERIC, 0, course_over_ground) \
+    FIELD(4, NMEA_FIELD_NUMERIC, 0, speed_over_ground_knots) \
+    FIELD(5, NMEA_FIELD_CHAR, 1, speed_over_ground_knots.unit_of_measurement) \
+    FIELD(6, NMEA_FIELD_NUMERIC, 0, speed_over_ground_kmh) \
+    FIELD(7, NMEA_FIELD_CHAR, 1, speed_over_ground_kmh.unit_of_measurement) \
+    FIELD(8, NMEA_FIELD_CHAR, 1, position_mode)
+
+const nmea_field_descriptor nmea_vtg_fields[] = { NMEA_VTG_FIELDS(SCHEMA_DESCRIPTOR) };
+
+#define NMEA_GSA_FIELDS(FIELD) \
+    FIELD(1, NMEA_FIELD_INTEGER, 1, fix_type) \
+    FIELD(14, NMEA_FIELD_NUMERIC, 0, pdop) \
+    FIELD(15, NMEA_FIELD_NUMERIC, 0, hdop) \
+    FIELD(16, NMEA_FIELD_NUMERIC, 0, vdop)
+
+const nmea_field_descriptor nmea_gsa_fields[] = { NMEA_GSA_FIELDS(SCHEMA_DESCRIPTOR) };
+
+#define NMEA_GLL_FIELDS(FIELD) \
+    FIELD(0, NMEA_FIELD_LATITUDE, 0, latitude) \
+    FIELD(1, NMEA_FIELD_HEMISPHERE, 1, latitude) \
+    FIELD(2, NMEA_FIELD_LONGITUDE, 0, longitude) \
+    FIELD(3, NMEA_FIELD_HEMISPHERE, 1, longitude) \
+    FIELD(4, NMEA_FIELD_TIME, 9, time_of_sample) \
+    FIELD(5, NMEA_FIELD_CHAR, 1, position_status) \
+    FIELD(6, NMEA_FIELD_CHAR, 1, position_mode)
+
+const nmea_field_descriptor nmea_gll_fields[] = { NMEA_GLL_FIELDS(SCHEMA_DESCRIPTOR) };
+
+const nmea_sentence_schema nmea_rmc_schema = NMEA_SENTENCE_SCHEMA(nmea_rmc_fields);
+const nmea_sentence_schema nmea_gga_schema = NMEA_SENTENCE_SCHEMA(nmea_gga_fields);
+const nmea_sentence_schema nmea_vtg_schema = NMEA_SENTENCE_SCHEMA(nmea_vtg_fields);
+const nmea_sentence_schema nmea_gsa_schema = NMEA_SENTENCE_SCHEMA(nmea_gsa_fields);
+const nmea_sentence_schema nmea_gll_schema = NMEA_SENTENCE_SCHEMA(nmea_gll_fields);
+
+// The measurements a schema writes to are saved on the stack while its sentence is decoded (see `M10GnssDriverSchemaParser`)
+_Static_assert(SCHEMA_SAVE_SIZE(NMEA_RMC_FIELDS) <= SCHEMA_SAVE_AREA_SIZE, "RMC schema larger than the save area");
+_Static_assert(SCHEMA_SAVE_SIZE(NMEA_GGA_FIELDS) <= SCHEMA_SAVE_AREA_SIZE, "GGA schema larger than the save area");
+_Static_assert(SCHEMA_SAVE_SIZE(NMEA_VTG_FIELDS) <= SCHEMA_SAVE_AREA_SIZE, "VTG schema larger than the save area");
+_Static_assert(SCHEMA_SAVE_SIZE(NMEA_GSA_FIELDS) <= SCHEMA_SAVE_AREA_SIZE, "GSA schema larger than the save area");
+_Static_assert(SCHEMA_SAVE_SIZE(NMEA_GLL_FIELDS) <= SCHEMA_SAVE_AREA_SIZE, "GLL schema larger than the save area");
+
+m10_gnss* m10_gnss_module = NULL;
+m10_gnss_stream_buffer stream_ring_buffer;                        // Filled by the transport reads, consumed by the parser
+m10_gnss_stream_buffer* raw_stream_buffer = &stream_ring_buffer;  // Or the transport's own `stream_buffer`, if any
+
+m10_gnss_parser stream_parser;                                    // Parses `raw_stream_buffer` into `m10_gnss_module`
+
+volatile stream_transfer_state raw_stream_buffer_transfer_state = TRANSFER_IDLE;
+uint16_t raw_stream_buffer_transfer_size = 0;  // Number of bytes requested by the DMA transfer in progress
+uint16_t raw_stream_buffer_pending_bytes = 0;  // Number of bytes reported by the module and not yet read
+
+volatile char tx_ready_triggered = 0;  // Set by the TX-ready EXTI, cleared when the drain starts
+volatile char rx_event_triggered = 0;  // Set by the transport at the end of a burst, cleared when the drain starts
+
+/**
+ * @internal 
+ * @brief Append a configuration key and its little endian value to an UBX-CFG-VALSET payload.
+ * 
+ * @return uint16_t Position in the frame after the appended item
+ * @endinternal 
+ */
+uint16_t M10GnssDriverAppendCfgItem(uint8_t* frame, uint16_t position, uint32_t key, uint16_t value, uint8_t value_size){
+
+    for (int i = 0; i < 4; i++)
+        frame[position++] = (uint8_t)(key >> (8 * i));
+
+    for (int i = 0; i < value_size; i++)
+        frame[position++] = (uint8_t)(value >> (8 * i));
+
+    return position;
+}
+
+/**
+ * @internal 
+ * @brief Write the header of an UBX-CFG-VALSET frame, and the start of its payload, to write the RAM layer.
+ * 
+ * @param frame: `uint8_t*` Frame to be written
+ * @param frame_size: `uint16_t` Number of bytes of the whole frame, header and checksum included
+ * @return uint16_t Position in the frame of the first configuration item
+ * @endinternal 
+ */
+uint16_t M10GnssDriverStartCfgValset(uint8_t* frame, uint16_t frame_size){
+    uint16_t position = 0;
+
+    frame[position++] = UBX_SYNC_CHAR_1;
+    frame[position++] = UBX_SYNC_CHAR_2;
+    frame[position++] = UBX_CLASS_CFG;
+    frame[position++] = UBX_ID_CFG_VALSET;
+    frame[position++] = (uint8_t)(frame_size - UBX_FRAME_OVERHEAD);
+    frame[position++] = (uint8_t)((frame_size - UBX_FRAME_OVERHEAD) >> 8);
+
+    frame[position++] = 0;                  // Message version
+    frame[position++] = UBX_CFG_LAYER_RAM;  // Layers to be written
+    frame[position++] = 0;                  // Reserved
+    frame[position++] = 0;                  // Reserved
+
+    return position;
+}
+
+/**
+ * @internal 
+ * @brief Program the module's TX-ready output through an UBX-CFG-VALSET message, written to the RAM layer.
+ *    The module then asserts the `tx_ready_pio` (active high) whenever the number of bytes waiting on the I2C
+ * interface crosses `tx_ready_threshold`, so the stream buffer is only read when there is data.
+ *    Since the configuration is only written to RAM, it is sent again on every initialization. TX-ready is not
+ * available on the other interfaces, so nothing is sent for them.
+ * 
+ * @endinternal 
+ */
+void M10GnssDriverConfigureTxReady(void){
+    uint8_t frame[UBX_CFG_TXREADY_FRAME_SIZE];
+    uint16_t position;
+    uint16_t threshold = (m10_gnss_module->tx_ready_threshold == 0)? TX_READY_DEFAULT_THRESHOLD : m10_gnss_module->tx_ready_threshold;
+    uint8_t pio = (m10_gnss_module->tx_ready_pio == 0)? TX_READY_DEFAULT_PIO : m10_gnss_module->tx_ready_pio;
+    m10_gnss_transport* transport = &m10_gnss_module->transport;
+
+    if(transport->write == NULL || transport->interface != I2C_TRANSPORT)
+        return;
+
+    position = M10GnssDriverStartCfgValset(frame, UBX_CFG_TXREADY_FRAME_SIZE);
+    position = M10GnssDriverAppendCfgItem(frame, position, CFG_TXREADY_ENABLED, 1, 1);
+    position = M10GnssDriverAppendCfgItem(frame, position, CFG_TXREADY_POLARITY, 0, 1);
+    position = M10GnssDriverAppendCfgItem(frame, position, CFG_TXREADY_PIN, pio, 1);
+    position = M10GnssDriverAppendCfgItem(frame, position, CFG_TXREADY_THRESHOLD, threshold / TX_READY_THRESHOLD_UNIT, 2);
+    position = M10GnssDriverAppendCfgItem(frame, position, CFG_TXREADY_INTERFACE, CFG_TXREADY_INTERFACE_I2C, 1);
+
+    UbxChecksum(&frame[2], position - 2, &frame[position]);
+    transport->write(transport, frame, UBX_CFG_TXREADY_FRAME_SIZE);
+}
+
+/**
+ * @internal 
+ * @brief Enable the UBX navigation messages parsed by the driver (`UBX-NAV-PVT`, `UBX-NAV-DOP`, `UBX-NAV-SAT` and
+ * `UBX-NAV-EOE`, once per epoch) on the interface of the transport, through an UBX-CFG-VALSET message written to
+ * the RAM layer. The NMEA output is left as it is, so both can be received on the same link.
+ * 
+ * @endinternal 
+ */
+void M10GnssDriverConfigureUbxOutput(void){
+    uint8_t frame[UBX_CFG_UBX_OUTPUT_FRAME_SIZE];
+    uint16_t position;
+    uint32_t key_offset = 0;
+    m10_gnss_transport* transport = &m10_gnss_module->transport;
+
+    if(transport->write == NULL || transport->interface == FILE_TRANSPORT)
+        return;
+
+    if(transport->interface == UART_TRANSPORT)
+        key_offset = CFG_MSGOUT_UART1_OFFSET;
+
+    position = M10GnssDriverStartCfgValset(frame, UBX_CFG_UBX_OUTPUT_FRAME_SIZE);
+    position = M10GnssDriverAppendCfgItem(frame, position, CFG_MSGOUT_UBX_NAV_PVT + key_offset, 1, 1);
+    position = M10GnssDriverAppendCfgItem(frame, position, CFG_MSGOUT_UBX_NAV_DOP + key_offset, 1, 1);
+    position = M10GnssDriverAppendCfgItem(frame, position, CFG_MSGOUT_UBX_NAV_SAT + key_offset, 1, 1);
+    position = M10GnssDriverAppendCfgItem(frame, position, CFG_MSGOUT_UBX_NAV_EOE + key_offset, 1, 1);
+
+    UbxChecksum(&frame[2], position - 2, &frame[position]);
+    transport->write(transport, frame, UBX_CFG_UBX_OUTPUT_FRAME_SIZE);
+}
+
+/**
+ * @internal 
+ * @brief Signal a rising edge on an EXTI line, flagging that the module has data if it matches the TX-ready pin.
+ * 
+ * @param gpio_pin: `uint16_t` Pin that generated the interrupt
+ * @endinternal 
+ */
+void M10GnssDriverExtiCallback(uint16_t gpio_pin){
+
+    if(m10_gnss_module == NULL || gpio_pin != m10_gnss_module->tx_ready_pin)
+        return;
+
+    tx_ready_triggered = 1;
+}
+
+/**
+ * @internal 
+ * @brief Signal the end of a burst of data on the transport, flagging that it should be read if it matches 
+ * the module's transport.
+ * 
+ * @param transport_handle: `void*` Handle of the peripheral that generated the event
+ * @endinternal 
+ */
+void M10GnssDriverRxEventCallback(void* transport_handle){
+
+    if(m10_gnss_module == NULL || transport_handle != m10_gnss_module->transport.handle)
+        return;
+
+    rx_event_triggered = 1;
+}
+
+/**
+ * @internal 
+ * @brief Check if the stream buffer should be read now.
+ *    With `TX_READY_TRIGGER`, the pin level is also checked, so data is not left behind if it stays asserted 
+ * after a drain (which would generate no new edge). With `IDLE_LINE_TRIGGER` there is no level to check, the 
+ * data received after the last event is read along with the next burst.
+ * 
+ * @return char `1` if the stream buffer should be read, `0` otherwise
+ * @endinternal 
+ */
+char M10GnssDriverIsReadTriggered(void){
 
-void M10GnssDriverRmcParser(nmea_caller_id* nmea_origin_id);
-void M10GnssDriverGsvParser(nmea_caller_id* nmea_origin_id);
+    if(m10_gnss_module->trigger_mode == IDLE_LINE_TRIGGER){
+        if(!rx_event_triggered)
+            return 0;
 
-nmea_message_parsing_table_entry nmea_message_parsing_table[NUM_PARSING_TABLE_ENTRIES] = {
+        rx_event_triggered = 0;
+        return 1;
+    }
+
+    if(m10_gnss_module->trigger_mode != TX_READY_TRIGGER)
+        return 1;
 
-                                                                {
-                                                                    .message_origin = "GNRMC",
-                                                                    .parser_function = M10GnssDriverRmcParser
-                                                                },
-                                                                {
-                                                                    .message_origin = "**GSV",
-                                                                    .parser_function = M10GnssDriverGsvParser
-                                                                }
-                                                            };
+    if(!tx_ready_triggered && HAL_GPIO_ReadPin(m10_gnss_module->tx_ready_port, m10_gnss_module->tx_ready_pin) == GPIO_PIN_RESET)
+        return 0;
 
-m10_gnss* m10_gnss_module;
-m10_gnss_stream_buffer raw_stream_buffer;
+    tx_ready_triggered = 0;
+    return 1;
+}
 
-parser_state raw_stream_buffer_parser_state = IDLE;
-nmea_caller_id message_origin;
+/**
+ * @internal 
+ * @brief Initialize a parser context, with no sentence in progress, the counters cleared and all the sentence 
+ * types subscribed.
+ * 
+ * @param parser: `m10_gnss_parser*` Parser context to be initialized
+ * @param stream_buffer: `m10_gnss_stream_buffer*` Ring buffer the sentences are read from
+ * @param m10_module: `m10_gnss*` Instance the parsed values are written to
+ * @endinternal 
+ */
+void M10GnssDriverParserInit(m10_gnss_parser* parser, m10_gnss_stream_buffer* stream_buffer, m10_gnss* m10_module){
+    memset(parser, 0, sizeof(m10_gnss_parser));
+    parser->stream_buffer = stream_buffer;
+    parser->module = m10_module;
+    parser->subscriptions = M10_GNSS_ALL_SENTENCES;
+    parser->epoch_key = EPOCH_KEY_UNKNOWN;
+    parser->ubx_epoch_key = EPOCH_KEY_UNKNOWN;
+    parser->ubx_utc_offset = EPOCH_KEY_UNKNOWN;
+    memcpy(&parser->epoch_record, m10_module, M10_GNSS_READINGS_SIZE);
+}
 
 /**
  * @internal 
@@ -77,325 +450,1335 @@ nmea_caller_id message_origin;
  * @param m10_module: `m10_gnss*` Pointer to an instance of m10_gnss
  * 
  *    Initializes the Driver by saving the pointer to the m10_gnss instance containing all the 
- * necessary files and the handler for the I2C com.
+ * necessary files and the transport to the module, which is then opened.
  *    Furthermore clears all the buffer from the Ublox module by reading it until empty, as to avoid 
- * computing old data.
+ * computing old data. A transport with its own `stream_buffer` is parsed in place, instead of being read into
+ * `stream_ring_buffer`. When using `TX_READY_TRIGGER`, the TX-ready output is programmed before that, so the
+ * first edge comes from fresh data, as is the UBX output when `ubx_output` is set. A recorded log (`FILE_TRANSPORT`) has no old data, so it is not cleared.
  * @endinternal 
  */
 void M10GnssDriverInit(m10_gnss* m10_module){
     m10_gnss_module = m10_module;
-    M10GnssDriverClearStreamBuffer();
+    raw_stream_buffer = (m10_module->transport.stream_buffer != NULL)?m10_module->transport.stream_buffer:&stream_ring_buffer;
+    M10GnssDriverParserInit(&stream_parser, raw_stream_buffer, m10_module);
+    m10_gnss_module->transport.open(&m10_gnss_module->transport);
+
+    if(m10_gnss_module->trigger_mode == TX_READY_TRIGGER)
+        M10GnssDriverConfigureTxReady();
+
+    if(m10_gnss_module->ubx_output)
+        M10GnssDriverConfigureUbxOutput();
+
+    if(m10_gnss_module->transport.interface != FILE_TRANSPORT)
+        M10GnssDriverClearStreamBuffer();
 }
 
 /**
  * @internal 
- * @brief Discard the message in the local buffer by incrementing the buffer index until a new line character \\n
- * is met.
- *    If the message was cut short (i.e the index reaches the last position before the new line character is found)
- * the system will go into the DISCARDING_MESSAGE mode and return, this way it ensures that after the next buffer read
- * it will resume here.
+ * @brief Advance the ring buffer tail to the start of the next frame, NMEA `$` or UBX sync character (without
+ * consuming it), scanning each contiguous part of the received data a word at a time with `NmeaScanDelimiters`.
+ * 
+ * @param parser: `m10_gnss_parser*` Parser context
+ * @return char `1` if found, `0` if the ring buffer was emptied without finding it
  * @endinternal 
  */
-void M10GnssDriverNmeaDiscardMessage(void){
-    // Set the status to discarding, so in case the buffer ends the next read will start here to end the discarding
-    raw_stream_buffer_parser_state = DISCARDING_MESSAGE;
-    while(raw_stream_buffer.buffer_index < raw_stream_buffer.buffer_size){
-
-        // if the end of message character is found, break from the loop and set the state back to idle
-        // so the next message can be parsed
-        if(raw_stream_buffer.buffer[raw_stream_buffer.buffer_index] == '\n')
-            break;
-
-        raw_stream_buffer.buffer_index++;
+char M10GnssDriverSkipToFrameStart(m10_gnss_parser* parser){
+    m10_gnss_stream_buffer* stream_buffer = parser->stream_buffer;
+
+    while(!STREAM_BUFFER_IS_EMPTY(stream_buffer)){
+        uint16_t tail = stream_buffer->tail;
+        uint16_t head = stream_buffer->head;
+        uint16_t limit = (head >= tail)?head:STREAM_RING_BUFFER_SIZE;
+        uint16_t offset = NmeaScanDelimiters(&stream_buffer->buffer[tail], limit - tail, MESSAGE_START, UBX_SYNC_CHAR_1, MESSAGE_START, UBX_SYNC_CHAR_1);
+
+        stream_buffer->tail = (tail + offset) & STREAM_RING_BUFFER_MASK;
+        if(tail + offset < limit)
+            return 1;
     }
 
-    raw_stream_buffer_parser_state = IDLE;
+    return 0;
 }
 
 /**
  * @internal 
- * @brief From the caller ID, delegates the parsing to the correct parsing function, established in the `nmea_message_parsing_table`
- * lookup table, with the ability to parse `*` wildcard for characters that do not matter for message -> parsing function matching 
+ * @brief Count the different satellites of a table, as a satellite has one entry per tracked signal.
  * 
- * @param nmea_origin_id: `nmea_caller_id*` Pointer to the nmea caller id of the message.
+ * @param table: `const gnss_satellite_table*` Satellite table
+ * @return uint8_t Number of different satellite IDs
  * @endinternal 
  */
-void M10GnssDriverNmeaMessageDelegator(nmea_caller_id* nmea_origin_id){
-    for (int parsing_table_index = 0; parsing_table_index < NUM_PARSING_TABLE_ENTRIES; parsing_table_index++){
-        nmea_message_parsing_table_entry nmea_callback_entry = nmea_message_parsing_table[parsing_table_index];
+uint8_t M10GnssDriverCountSatellites(const gnss_satellite_table* table){
+    uint8_t num_satellites = 0;
 
-        char nmea_caller_compare_result = NmeaParserCompareOriginId(nmea_origin_id, nmea_callback_entry.message_origin);
-        if(nmea_caller_compare_result == 0)
-            continue;
+    for(uint8_t entry = 0; entry < table->count; entry++){
+        uint8_t previous = 0;
 
-        (*nmea_callback_entry.parser_function)(nmea_origin_id);
-        return;
+        while(previous < entry && table->prn[previous] != table->prn[entry])
+            previous++;
+
+        num_satellites += (previous == entry);
     }
 
-    // If there was no match in the table, discard the incoming message
-    M10GnssDriverNmeaDiscardMessage();
-    
+    return num_satellites;
 }
 
 /**
  * @internal 
- * @brief Gets the number of bytes in the module's stream buffer.
+ * @brief Commit the epoch being received: publish the satellite tables of the GSV groups completed in the epoch, 
+ * and copy the epoch record to the module instance at once, so its readings all come from the same epoch. The
+ * module's `epoch_callback` is then called, if any. Nothing is done if no reading was received since the last commit.
+ *    The epoch stays the current one until another one starts, so that the messages of the other protocol that are
+ * still to come for it are recognized as late (see `M10GnssDriverJoinEpoch`).
  * 
- * @return uint16_t Number of bytes to be read in the buffer
+ * @param parser: `m10_gnss_parser*` Parser context
  * @endinternal 
  */
-uint16_t M10GnssDriverGetStreamBufferSize(void){
-        
-        unsigned char raw_buffer_val;
-        uint16_t buffer_size = 0;
+void M10GnssDriverCommitEpoch(m10_gnss_parser* parser){
+    if(!parser->epoch_pending)
+        return;
+
+    for(gnss_constellation constellation = 0; constellation < NUM_GNSS_CONSTELLATIONS; constellation++){
+        m10_gnss_gsv_group* group = &parser->gsv_groups[constellation];
+        gnss_satellite_table* satellites = &parser->satellites[constellation];
+
+        if(!(parser->epoch_constellations & (1 << constellation)))
+            continue;
 
-        HAL_I2C_Mem_Read(m10_gnss_module->i2c_handle, m10_gnss_module->i2c_address, AVAILABLE_BUFFER_HB, STREAM_BUFFER_REGISTER_SIZE, &raw_buffer_val, 1, 10000);
-        buffer_size |= raw_buffer_val<<4;
+        *satellites = group->satellites;
+        // Leave out the group in progress, if any
+        if(group->next_message != 0)
+            satellites->count = group->first_entry;
 
-        HAL_I2C_Mem_Read(m10_gnss_module->i2c_handle, m10_gnss_module->i2c_address, AVAILABLE_BUFFER_LB, STREAM_BUFFER_REGISTER_SIZE, &raw_buffer_val, 1, 10000);
-        buffer_size |= raw_buffer_val;
-        return buffer_size;
+        satellites->num_satellites = M10GnssDriverCountSatellites(satellites);
+        satellites->is_available = 1;
+        ((unsigned char*)&parser->epoch_record.num_available_satelites)[available_satelites_offsets[constellation]] = satellites->num_satellites;
+    }
+
+    parser->epoch_record.epoch++;
+    memcpy(parser->module, &parser->epoch_record, M10_GNSS_READINGS_SIZE);
+    parser->epoch_pending = 0;
+    parser->epoch_committed = 1;
+    parser->epoch_sentences = 0;
+    parser->epoch_constellations = 0;
+
+    if(parser->module->epoch_callback != NULL)
+        parser->module->epoch_callback(parser->module);
 }
 
 /**
  * @internal 
- * @brief Read the data in the module's stream buffer through I2C.
- *    The Maximum number of bytes to be read at one time is 400, to change this limit
- * it is necessary to change the size of STACK_BUFFER_ARRAY_SIZE, although it is necessary to 
- * be mindful of the available stack size.
+ * @brief Get the UTC time of day of a time in milliseconds. It is also the epoch key of a message, the same for the
+ * NMEA sentences and the UBX messages of an epoch.
  * 
+ * @param date_time: `const utc_date_time*` UTC time of a message
+ * @return uint32_t Milliseconds since 00:00:00, `GNSS_TIME_OF_DAY_UNKNOWN` if the time is not available
  * @endinternal 
  */
-void M10GnssDriverReadStreamBuffer(void){
+uint32_t M10GnssDriverGetTimeOfDayMs(const utc_date_time* date_time){
+    if(!date_time->is_available)
+        return GNSS_TIME_OF_DAY_UNKNOWN;
 
-        raw_stream_buffer.buffer_size = M10GnssDriverGetStreamBufferSize();
-        raw_stream_buffer.buffer_size = (raw_stream_buffer.buffer_size > STACK_BUFFER_ARRAY_SIZE)?STACK_BUFFER_ARRAY_SIZE:raw_stream_buffer.buffer_size;
-        HAL_I2C_Mem_Read(m10_gnss_module->i2c_handle, m10_gnss_module->i2c_address, STREAM_BUFFER_REGISTER, STREAM_BUFFER_REGISTER_SIZE, &raw_stream_buffer.buffer, raw_stream_buffer.buffer_size, 10000);
-        raw_stream_buffer.buffer_index = 0;
+    return date_time->hour * 3600000UL + date_time->minute * 60000UL + M10GnssDriverGetSecondScaled(date_time);
 }
 
 /**
  * @internal 
- * @brief Clear the module's stream buffer.
- *    It tries a maximum of 50 times to clear the buffer or until the stream buffer size is reported as 0
- * by the module. This limit is a way to avoid getting stuck if, by any chance, the buffer is being filled
- * faster than we are able to clear it.
+ * @brief Check if a message starts a new epoch: its key is not the one of the epoch being received, or its
+ * protocol already ended the epoch (for messages without a time).
  * 
+ * @param parser: `m10_gnss_parser*` Parser context
+ * @param source: `uint8_t` Protocol of the message, `EPOCH_SOURCE_NMEA` or `EPOCH_SOURCE_UBX`
+ * @param key: `uint32_t` Epoch key of the message, `EPOCH_KEY_UNKNOWN` if it has no time
+ * @return char `1` if the message belongs to a new epoch
  * @endinternal 
  */
-void M10GnssDriverClearStreamBuffer(void){
-
-    for (int i = 0; i < 50; i++){
-        M10GnssDriverReadStreamBuffer();
-        if(raw_stream_buffer.buffer_size == 0)
-            return;
-    }
-    
+char M10GnssDriverIsNewEpoch(m10_gnss_parser* parser, uint8_t source, uint32_t key){
+    return (parser->epoch_sources_ended & source) ||
+           (key != EPOCH_KEY_UNKNOWN && parser->epoch_key != EPOCH_KEY_UNKNOWN && key != parser->epoch_key);
 }
 
 /**
  * @internal 
- * @brief Parse a new message by first parsing the caller id (first 5 characters) and calling the message delegator.
- *    If the message was cut in the middle of its caller id due to buffer size limits, it keeps track of the caller id
- * index (used to construct a local copy of the caller id to latter be compared by the Message Delegator), and by that 
- * in the next parsing iteration (after the buffer read call) it resumes parsing the caller id.
+ * @brief Start a new epoch, committing the epoch being received if it was not committed yet. The protocols of
+ * the finished epoch are the ones expected to end the new one, and the measurements of the epoch record are
+ * flagged unavailable until a message of the new epoch writes them.
  * 
+ * @param parser: `m10_gnss_parser*` Parser context
+ * @param source: `uint8_t` Protocol of the message starting the epoch
+ * @param key: `uint32_t` Epoch key of the message, `EPOCH_KEY_UNKNOWN` if it has no time
  * @endinternal 
  */
-void M10GnssDriverParseNewMessage(void){
-    static int nmea_caller_id_index;
-    unsigned char stream_character = raw_stream_buffer.buffer[raw_stream_buffer.buffer_index];
-        raw_stream_buffer.buffer_index++;
+void M10GnssDriverStartEpoch(m10_gnss_parser* parser, uint8_t source, uint32_t key){
+    M10GnssDriverCommitEpoch(parser);
 
-        if(stream_character == '$'){
-            nmea_caller_id_index = 0;
-        }
-        else if(stream_character == ','){
-            M10GnssDriverNmeaMessageDelegator(message_origin);
-        }
-        else{
-            message_origin[nmea_caller_id_index] = stream_character;
-            nmea_caller_id_index++;
-        }
+    if(parser->epoch_sources != 0)
+        parser->expected_sources = parser->epoch_sources;
+
+    parser->epoch_key = key;
+    parser->epoch_sources = source;
+    parser->epoch_sources_ended = 0;
+    parser->epoch_committed = 0;
+    parser->epoch_sentences = 0;
+
+    for(unsigned char flag = 0; flag < sizeof(epoch_availability_offsets); flag++)
+        ((char*)&parser->epoch_record)[epoch_availability_offsets[flag]] = 0;
 }
 
 /**
  * @internal 
- * @brief Parse the data streamed from the module.
- *    This function is also responsible to resume the correct parsing context based on the termination status of the  
- * previous iteration, i.e if the last buffer was complete, it will start parsing a new message. If the last buffer  
- * was already parsing a message, it will call the message delegator (hence the importance off the message parsing
- * functions to be able to retain context in between calls in case of message spliting). And finally if a message 
- * was being discarded (because no callback is listed) it shall call `M10GnssDriverNemeaDiscardMessage` at once.
+ * @brief Add a message to the epoch it belongs to, starting a new epoch if needed.
+ *    A message of an epoch that was already committed, when the other protocol ended it first, is late: its
+ * readings were already published (or superseded), and it must be dropped so the epoch is not committed twice.
  * 
+ * @param parser: `m10_gnss_parser*` Parser context
+ * @param source: `uint8_t` Protocol of the message, `EPOCH_SOURCE_NMEA` or `EPOCH_SOURCE_UBX`
+ * @param key: `uint32_t` Epoch key of the message, `EPOCH_KEY_UNKNOWN` if it has no time
+ * @return char `1` if the message is to be decoded into the epoch record, `0` if it is late
  * @endinternal 
  */
-void M10GnssDriverParseBuffer(void){
+char M10GnssDriverJoinEpoch(m10_gnss_parser* parser, uint8_t source, uint32_t key){
+    if(M10GnssDriverIsNewEpoch(parser, source, key)){
+        M10GnssDriverStartEpoch(parser, source, key);
+        return 1;
+    }
 
-    while(raw_stream_buffer.buffer_index < raw_stream_buffer.buffer_size){
+    if(parser->epoch_key == EPOCH_KEY_UNKNOWN)
+        parser->epoch_key = key;
 
-        switch (raw_stream_buffer_parser_state){
+    parser->epoch_sources |= source;
+    return !parser->epoch_committed;
+}
 
-            case IDLE:
-                M10GnssDriverParseNewMessage();
-                break;
+/**
+ * @internal 
+ * @brief Signal the last message of an epoch in a protocol (GLL or UBX-NAV-EOE). The epoch is committed once all
+ * the protocols it is expected from ended it, so a stream with both protocols commits each epoch once, with the
+ * readings of both.
+ * 
+ * @param parser: `m10_gnss_parser*` Parser context
+ * @param source: `uint8_t` Protocol of the message, `EPOCH_SOURCE_NMEA` or `EPOCH_SOURCE_UBX`
+ * @endinternal 
+ */
+void M10GnssDriverEndEpoch(m10_gnss_parser* parser, uint8_t source){
+    uint8_t sources = parser->epoch_sources | parser->expected_sources;
 
-            case PARSING:
-                M10GnssDriverNmeaMessageDelegator(message_origin);
-                break;
-        
-            case DISCARDING_MESSAGE:
-                M10GnssDriverNmeaDiscardMessage();
-                break;
+    parser->epoch_sources_ended |= source;
+    if((parser->epoch_sources_ended & sources) == sources)
+        M10GnssDriverCommitEpoch(parser);
+}
 
-            default:
-                break;
+/**
+ * @internal 
+ * @brief Save the measurements a schema writes to, or exchange them with the ones saved before.
+ *    Each destination is saved once, the fields that write into the measurement of an earlier field being covered
+ * by it, so at most `SCHEMA_SAVE_SIZE` bytes are used, which is checked at compile time for every schema.
+ * 
+ * @param record: `m10_gnss*` Record the schema writes to
+ * @param schema: `const nmea_sentence_schema*` Description of the sentence's fields
+ * @param save_area: `unsigned char*` Area of `SCHEMA_SAVE_AREA_SIZE` bytes with the saved measurements
+ * @param exchange: `char` `0` to save the measurements of `record`, `1` to exchange them with the saved ones
+ * @endinternal 
+ */
+void M10GnssDriverSaveSchemaFields(m10_gnss* record, const nmea_sentence_schema* schema, unsigned char* save_area, char exchange){
+    for(unsigned char field = 0; field < schema->num_fields; field++){
+        uint16_t offset = schema->fields[field].offset;
+        unsigned char size = NmeaGetFieldSize(schema->fields[field].type);
+        unsigned char* destination = (unsigned char*)record + offset;
+        unsigned char previous = 0;
+
+        // Hemispheres, dates and units of measurement write into the measurement of an earlier field
+        while(previous < field && !(offset >= schema->fields[previous].offset &&
+              offset + size <= schema->fields[previous].offset + NmeaGetFieldSize(schema->fields[previous].type)))
+            previous++;
+
+        if(previous < field)
+            continue;
+
+        for(unsigned char i = 0; i < size; i++){
+            unsigned char value = destination[i];
+            if(exchange)
+                destination[i] = save_area[i];
+            save_area[i] = value;
         }
 
-        
+        save_area += size;
     }
-    
 }
 
 /**
  * @internal 
- * @brief Read and parse the data on the module's stream buffer.
+ * @brief Parse a sentence described by a schema.
+ *    The fields are decoded straight into the epoch record, after saving the measurements the schema writes to.
+ * If the sentence checksum does not match they are restored, so a corrupted sentence cannot overwrite a good fix,
+ * as they are for a late sentence of an epoch already committed. If the sentence belongs to the next epoch, they
+ * are exchanged with the saved ones while the current epoch is committed.
  * 
+ * @param parser: `m10_gnss_parser*` Parser context, with the instance the values are written to
+ * @param sentence: `nmea_sentence*` Sentence positioned on its first data field
+ * @param schema: `const nmea_sentence_schema*` Description of the sentence's fields
+ * @param reject_counter: `uint32_t*` Counter of the sentence type, incremented if the checksum does not match
  * @endinternal 
  */
-void M10GnssDriverReadData(void){
+void M10GnssDriverSchemaParser(m10_gnss_parser* parser, nmea_sentence* sentence, const nmea_sentence_schema* schema, uint32_t* reject_counter){
+    unsigned char save_area[SCHEMA_SAVE_AREA_SIZE];
+    uint32_t key = EPOCH_KEY_UNKNOWN;
 
-    M10GnssDriverReadStreamBuffer();
+    M10GnssDriverSaveSchemaFields(&parser->epoch_record, schema, save_area, 0);
 
-    if(raw_stream_buffer.buffer_size == 0)
+    if(!NmeaParseSentence(sentence, schema, &parser->epoch_record)){
+        M10GnssDriverSaveSchemaFields(&parser->epoch_record, schema, save_area, 1);
+        (*reject_counter)++;
         return;
+    }
+
+    for(unsigned char field = 0; field < schema->num_fields; field++){
+        if(schema->fields[field].type == NMEA_FIELD_TIME)
+            key = M10GnssDriverGetTimeOfDayMs(&parser->epoch_record.time_of_sample);
+    }
 
-    // If the first element is $, force the state back to idle, to avoid parsing error propagation
-    if(raw_stream_buffer.buffer[0] == '$')
-        raw_stream_buffer_parser_state = IDLE;
+    // The decoded sentence is kept aside while the epoch it does not belong to is committed
+    if(M10GnssDriverIsNewEpoch(parser, EPOCH_SOURCE_NMEA, key)){
+        M10GnssDriverSaveSchemaFields(&parser->epoch_record, schema, save_area, 1);
+        M10GnssDriverStartEpoch(parser, EPOCH_SOURCE_NMEA, key);
+        M10GnssDriverSaveSchemaFields(&parser->epoch_record, schema, save_area, 1);
+    }
 
-    M10GnssDriverParseBuffer();
-    
+    if(!M10GnssDriverJoinEpoch(parser, EPOCH_SOURCE_NMEA, key)){
+        M10GnssDriverSaveSchemaFields(&parser->epoch_record, schema, save_area, 1);
+        return;
+    }
+
+    parser->epoch_pending = 1;
 }
 
 /**
- * @internal
- * @brief Parses NMEA messages of type RMC (Recommended minimum data), as described in the 
- * user's manual: https://content.u-blox.com/sites/default/files/u-blox-M10-SPG-5.10_InterfaceDescription_UBX-21035062.pdf
+ * @internal 
+ * @brief Get the type of a sentence from its address field, through the `NMEA_PARSING_TABLE`, with a single 
+ * `switch` on the formatter followed by the talker check (with its `*` wildcards) of the matching entry.
  * 
- * @param nmea_origin_id: `nmea_caller_id*` pointer to the caller id (i.e the constellation) that generated the message.
- * @endinternal
+ * @param address: `const nmea_field_span*` Address field of the sentence
+ * @return m10_gnss_sentence_type `OTHER_SENTENCE` if there is no match in the table
+ * @endinternal 
  */
-void M10GnssDriverRmcParser(nmea_caller_id* nmea_origin_id){
+m10_gnss_sentence_type M10GnssDriverGetSentenceType(const nmea_field_span* address){
+    const char* message_origin = address->data;
 
-    static char raw_field_data[20];           // Buffer containing the raw NMEA field
-    static int field_index;                   // Index of the field being parsed at the moment
-    
-    raw_stream_buffer_parser_state = PARSING; // Set the parser state to PARSING, so if message is cut due to buffer limit, resume parsing here
+    if(address->length != NMEA_TALKER_SIZE + NMEA_FORMATTER_SIZE)
+        return OTHER_SENTENCE;
+
+    #define NMEA_TYPE_CASE(talker_1, talker_2, formatter_1, formatter_2, formatter_3, sentence_type, ...) \
+            case NMEA_FORMATTER_KEY(formatter_1, formatter_2, formatter_3):                              \
+                return NMEA_TALKER_MATCHES(message_origin, talker_1, talker_2)?sentence_type:OTHER_SENTENCE;
 
-    while(field_index < 15){
+    switch(NMEA_FORMATTER_KEY(message_origin[2], message_origin[3], message_origin[4])){
+        NMEA_PARSING_TABLE(NMEA_TYPE_CASE, NMEA_TYPE_CASE)
 
-        // If parsing en route but the message was cut due to buffer size constraints, just return to ParseBuffer function with the
-        // parser state still as PARSING, and field index as 0, so it will continue the parsing here
-        nmea_raw_field_metadata field_metadata = NmeaGetNextFieldRaw(&raw_stream_buffer, &raw_field_data);
-        if(field_metadata.field_status == PARSING_EN_ROUTE)
-                    return;
+        default:
+            return OTHER_SENTENCE;
+    }
 
-        switch (field_index){
+    #undef NMEA_TYPE_CASE
+}
 
-            case 0:
-                
-                if(field_metadata.field_status != VALID || field_metadata.raw_field_length != 9){
-                    // If the field is not valid,  but also not en_route, just considere it as unavailable and continue parsing the next field
-                    m10_gnss_module->time_of_sample.is_available = 0;
-                    break;
-                }
+/**
+ * @internal 
+ * @brief From the caller ID, delegates the parsing to the correct parsing function, established in the `NMEA_PARSING_TABLE`.
+ * Messages with no match in the table, or whose type is not subscribed, are skipped right after the address field.
+ *    The caller ID is the address field of the sentence (after the `$`, up to the first `,`), and the parsing 
+ * function gets the sentence positioned on the first data field.
+ * 
+ * @param parser: `m10_gnss_parser*` Parser context
+ * @param sentence: `nmea_sentence*` Complete sentence, starting with `$`
+ * @endinternal 
+ */
+void M10GnssDriverNmeaMessageDelegator(m10_gnss_parser* parser, nmea_sentence* sentence){
+    nmea_caller_id message_origin = {0};
+
+    sentence->position = 1;
+    sentence->checksum = 0;
+    nmea_field_span address = NmeaGetNextField(sentence);
+    m10_gnss_sentence_type sentence_type = (address.field_status == END_OF_MESSAGE)?OTHER_SENTENCE:M10GnssDriverGetSentenceType(&address);
+
+    if(sentence_type == OTHER_SENTENCE || !(parser->subscriptions & M10_GNSS_SUBSCRIBE(sentence_type))){
+        parser->sentence_bytes[sentence_type].skipped += sentence->length;
+        return;
+    }
 
-                NmeaParseUtcTime(&(m10_gnss_module->time_of_sample), &raw_field_data);
+    parser->sentence_bytes[sentence_type].decoded += sentence->length;
+    memcpy(message_origin, address.data, address.length);
+
+    #define NMEA_SCHEMA_CASE(talker_1, talker_2, formatter_1, formatter_2, formatter_3, sentence_type, schema, reject_counter) \
+            case sentence_type:                                                                                         \
+                M10GnssDriverSchemaParser(parser, sentence, &schema, &parser->reject_count.reject_counter);             \
                 break;
 
-            case 1:
+    #define NMEA_PARSER_CASE(talker_1, talker_2, formatter_1, formatter_2, formatter_3, sentence_type, parser_function) \
+            case sentence_type:                                                                                  \
+                parser_function(parser, &message_origin, sentence);                                              \
                 break;
 
-            case 2:
-                if(field_metadata.field_status != VALID || field_metadata.raw_field_length != 10){
-                    m10_gnss_module->latitude.is_available = 0;
-                    break;
-                }
+    // A sentence sent once per epoch that was already received belongs to the next epoch
+    if(parser->epoch_sentences & M10_GNSS_SUBSCRIBE(sentence_type) & EPOCH_SINGLE_SENTENCES)
+        M10GnssDriverStartEpoch(parser, EPOCH_SOURCE_NMEA, EPOCH_KEY_UNKNOWN);
 
-                NmeaParseLatLong(&(m10_gnss_module->latitude), &raw_field_data, LATITUDE);
-                m10_gnss_module->latitude.is_available = 1;
-                break;
+    switch(sentence_type){
+        NMEA_PARSING_TABLE(NMEA_SCHEMA_CASE, NMEA_PARSER_CASE)
 
-            case 3:
-                if(field_metadata.field_status != VALID || field_metadata.raw_field_length != 1){
-                    break;
-                }
+        default:
+            return;
+    }
 
-                m10_gnss_module->latitude.indicator = raw_field_data[0];
-                break;
+    #undef NMEA_SCHEMA_CASE
+    #undef NMEA_PARSER_CASE
 
-            case 4:
-                if(field_metadata.field_status != VALID || field_metadata.raw_field_length != 11){
-                    m10_gnss_module->longitude.is_available = 0;
-                    break;
-                }
+    parser->epoch_sentences |= M10_GNSS_SUBSCRIBE(sentence_type);
+    if(sentence_type == EPOCH_LAST_SENTENCE)
+        M10GnssDriverEndEpoch(parser, EPOCH_SOURCE_NMEA);
+}
 
-                NmeaParseLatLong(&(m10_gnss_module->longitude), &raw_field_data, LONGITUDE);
-                m10_gnss_module->longitude.is_available = 1;
-                break;
+/**
+ * @internal 
+ * @brief Hand a complete sentence to the parsers, without the `\r` before its `\n`.
+ * 
+ * @param parser: `m10_gnss_parser*` Parser context
+ * @param data: `const char*` `$` of the sentence
+ * @param length: `uint16_t` Number of characters up to the `\n` (excluded)
+ * @endinternal 
+ */
+void M10GnssDriverDispatchSentence(m10_gnss_parser* parser, const char* data, uint16_t length){
+    nmea_sentence sentence = {
+                                .data = data,
+                                .length = (length > 0 && data[length - 1] == '\r')?length - 1:length,
+                                .position = 0,
+                                .checksum = 0
+                            };
+
+    M10GnssDriverNmeaMessageDelegator(parser, &sentence);
+}
 
-            case 5:
-                if(field_metadata.field_status != VALID || field_metadata.raw_field_length != 1){
-                    break;
-                }
+/**
+ * @internal 
+ * @brief Query the module's stream buffer size once and set it as the number of bytes to be drained.
+ *    The backlog is limited by the free space in the ring buffer, whatever is left stays in the module's own 
+ * buffer and is read on the next poll, instead of being dropped.
+ * 
+ * @endinternal 
+ */
+void M10GnssDriverQueryPendingBytes(void){
+        uint16_t free_space = STREAM_BUFFER_FREE_SPACE(raw_stream_buffer);
 
-                m10_gnss_module->longitude.indicator = raw_field_data[0];
-                break;
+        raw_stream_buffer_pending_bytes = m10_gnss_module->transport.bytes_available(&m10_gnss_module->transport);
+        raw_stream_buffer_pending_bytes = (raw_stream_buffer_pending_bytes > free_space)?free_space:raw_stream_buffer_pending_bytes;
+}
 
-            case 6:
-                if(field_metadata.field_status != VALID){
-                    m10_gnss_module->speed_over_ground_knots.is_available = 0;
-                    break;
-                }
+/**
+ * @internal 
+ * @brief Get the number of bytes to be requested in the next chunk of the drain.
+ *    Transfers always target a contiguous region of the ring buffer, so the chunk is limited by the pending 
+ * bytes, by STREAM_BUFFER_READ_CHUNK_SIZE and by the distance to the end of the ring.
+ * 
+ * @return uint16_t Number of bytes to be read, 0 if the drain is over
+ * @endinternal 
+ */
+uint16_t M10GnssDriverGetChunkSize(void){
+        uint16_t chunk_size = raw_stream_buffer_pending_bytes;
+        uint16_t contiguous_space = STREAM_RING_BUFFER_SIZE - raw_stream_buffer->head;
 
-                m10_gnss_module->speed_over_ground_knots.value = NmeaParseNumericFloatingPoint(&raw_field_data);
-                m10_gnss_module->speed_over_ground_knots.is_available = 1;
-                break;
+        chunk_size = (chunk_size > STREAM_BUFFER_READ_CHUNK_SIZE)?STREAM_BUFFER_READ_CHUNK_SIZE:chunk_size;
+        chunk_size = (chunk_size > contiguous_space)?contiguous_space:chunk_size;
+        return chunk_size;
+}
 
-            case 7:
-                if(field_metadata.field_status != VALID){
-                    m10_gnss_module->course_over_ground.is_available = 0;
-                    break;
-                }
+/**
+ * @internal 
+ * @brief Drain the module's stream buffer through the transport, appending it to the ring buffer.
+ *    The byte count is queried only once, and then the whole reported backlog is read in chunks of up to 
+ * STREAM_BUFFER_READ_CHUNK_SIZE bytes, so a full navigation epoch arrives in a single poll.
+ *    A transport with its own `stream_buffer` already holds the data in the ring, and only publishes it.
+ * 
+ * @return uint16_t Number of bytes read (or published, waiting to be parsed)
+ * @endinternal 
+ */
+uint16_t M10GnssDriverReadStreamBuffer(void){
+        uint16_t bytes_read = 0;
 
-                m10_gnss_module->course_over_ground.value = NmeaParseNumericFloatingPoint(&raw_field_data);
-                m10_gnss_module->course_over_ground.is_available = 1;
-                break;
+        if(m10_gnss_module->transport.stream_buffer != NULL)
+            return m10_gnss_module->transport.bytes_available(&m10_gnss_module->transport);
 
-            case 8:
-                if(field_metadata.field_status != VALID || field_metadata.raw_field_length != 6){
-                    break;
-                }
+        M10GnssDriverQueryPendingBytes();
+        while(raw_stream_buffer_pending_bytes > 0){
+            uint16_t chunk_size = M10GnssDriverGetChunkSize();
 
-                NmeaParseUtcDate(&(m10_gnss_module->time_of_sample), &raw_field_data);
+            if(m10_gnss_module->transport.read(&m10_gnss_module->transport, &raw_stream_buffer->buffer[raw_stream_buffer->head], chunk_size) != HAL_OK){
+                raw_stream_buffer_pending_bytes = 0;
                 break;
+            }
 
-            default:
-                break;
+            STREAM_BUFFER_COMMIT(raw_stream_buffer, chunk_size);
+            raw_stream_buffer_pending_bytes -= chunk_size;
+            bytes_read += chunk_size;
         }
-    
-        field_index++;
 
-        if(field_metadata.field_status == END_OF_MESSAGE){
-            field_index = 0;
-            raw_stream_buffer_parser_state = IDLE;
-            return;
-        }
-    
-    }
-    
+        return bytes_read;
 }
 
-void M10GnssDriverGsvParser(nmea_caller_id* nmea_origin_id){
+/**
+ * @internal 
+ * @brief Start a DMA read of the next chunk of the drain.
+ *    The chunk is moved by the DMA straight into the free region of the ring buffer, and the new bytes only 
+ * become visible to the parser when `M10GnssDriverRxCompleteCallback` commits them. The completion callback 
+ * then chains the next chunk, until the pending bytes are over.
+ *    If there is nothing left to drain, or the transport refuses the transfer, the transfer state is left as TRANSFER_IDLE
+ * so the next call to `M10GnssDriverReadData` queries the module again.
+ * 
+ * @endinternal 
+ */
+void M10GnssDriverStartStreamBufferTransfer(void){
+
+        raw_stream_buffer_transfer_size = M10GnssDriverGetChunkSize();
+        if(raw_stream_buffer_transfer_size == 0)
+            return;
+
+        raw_stream_buffer_transfer_state = TRANSFER_IN_PROGRESS;
+        if(m10_gnss_module->transport.read_async(&m10_gnss_module->transport, &raw_stream_buffer->buffer[raw_stream_buffer->head], raw_stream_buffer_transfer_size) != HAL_OK){
+            raw_stream_buffer_pending_bytes = 0;
+            raw_stream_buffer_transfer_state = TRANSFER_IDLE;
+        }
+}
+
+/**
+ * @internal 
+ * @brief Signal the end of a DMA stream buffer transfer.
+ *    Acts as the producer side of the ring buffer: the received bytes are committed by advancing the head
+ * index, which is the only shared state written from the interrupt context, so the parser never needs to
+ * mask interrupts. If the drain is not over, the next chunk is started right away.
+ * 
+ * @param transport_handle: `void*` Handle of the peripheral that finished the transfer
+ * @endinternal 
+ */
+void M10GnssDriverRxCompleteCallback(void* transport_handle){
+
+    if(m10_gnss_module == NULL || transport_handle != m10_gnss_module->transport.handle)
+        return;
+
+    STREAM_BUFFER_COMMIT(raw_stream_buffer, raw_stream_buffer_transfer_size);
+    raw_stream_buffer_pending_bytes -= raw_stream_buffer_transfer_size;
+    raw_stream_buffer_transfer_state = TRANSFER_IDLE;
+
+    // Chain the next chunk of the drain, without querying the byte count again
+    if(raw_stream_buffer_pending_bytes > 0)
+        M10GnssDriverStartStreamBufferTransfer();
+}
+
+/**
+ * @internal 
+ * @brief Signal a failed DMA stream buffer transfer.
+ *    The partially received data is dropped (the head index is not advanced), the rest of the drain is 
+ * abandoned and the transfer is flagged as idle, so the next call of `M10GnssDriverReadData` starts a new one.
+ * 
+ * @param transport_handle: `void*` Handle of the peripheral that reported the error
+ * @endinternal 
+ */
+void M10GnssDriverRxErrorCallback(void* transport_handle){
+
+    if(m10_gnss_module == NULL || transport_handle != m10_gnss_module->transport.handle)
+        return;
+
+    raw_stream_buffer_pending_bytes = 0;
+    raw_stream_buffer_transfer_state = TRANSFER_IDLE;
+}
+
+/**
+ * @internal 
+ * @brief Signal that the transport dropped received data (e.g. DMA overrun). The sentence or UBX frame split 
+ * before the gap is dropped, so its start is not joined to the bytes received after it.
+ *    Called from the main loop (`bytes_available`), never while the parser runs.
+ * 
+ * @param transport_handle: `void*` Handle of the peripheral that dropped the data
+ * @endinternal 
+ */
+void M10GnssDriverRxDataLostCallback(void* transport_handle){
+
+    if(m10_gnss_module == NULL || transport_handle != m10_gnss_module->transport.handle)
+        return;
+
+    stream_parser.sentence_carry_length = 0;
+    stream_parser.ubx_carry_length = 0;
+    stream_parser.ubx_frame_length = 0;
+}
+
+/**
+ * @internal 
+ * @brief Clear the module's stream buffer.
+ *    It tries a maximum of 50 times to clear the buffer or until the stream buffer size is reported as 0
+ * by the module. This limit is a way to avoid getting stuck if, by any chance, the buffer is being filled
+ * faster than we are able to clear it.
+ * 
+ * @endinternal 
+ */
+void M10GnssDriverClearStreamBuffer(void){
+
+    for (int i = 0; i < 50; i++){
+        uint16_t transfer_size = M10GnssDriverReadStreamBuffer();
+        raw_stream_buffer->tail = raw_stream_buffer->head;
+        stream_parser.sentence_carry_length = 0;
+        stream_parser.ubx_carry_length = 0;
+        stream_parser.ubx_frame_length = 0;
+
+        if(transfer_size == 0)
+            return;
+    }
+    
+}
+
+/**
+ * @internal 
+ * @brief Frame the sentence starting at the tail (on its `$`), looking for its `\n` a word at a time.
+ *    In the common case the whole sentence is already in the ring buffer, contiguous, and it is parsed in place.
+ * Otherwise (read boundary, end of the ring, or padding in the middle of it) what was received is moved to the 
+ * carry buffer, to be completed by `M10GnssDriverAssembleSentence`. A new `$` (or UBX sync character) before the
+ * `\n` drops the sentence, as does a sentence longer than NMEA_SENTENCE_MAX_SIZE.
+ * 
+ * @param parser: `m10_gnss_parser*` Parser context
+ * @endinternal 
+ */
+void M10GnssDriverFrameSentence(m10_gnss_parser* parser){
+    m10_gnss_stream_buffer* stream_buffer = parser->stream_buffer;
+    uint16_t start = stream_buffer->tail;
+    uint16_t head = stream_buffer->head;
+    uint16_t limit = (head >= start)?head:STREAM_RING_BUFFER_SIZE;
+    uint16_t scan_size = (limit - start > NMEA_SENTENCE_MAX_SIZE)?NMEA_SENTENCE_MAX_SIZE:limit - start;
+    uint16_t length = 1 + NmeaScanDelimiters(&stream_buffer->buffer[start + 1], scan_size - 1, MESSAGE_END, MESSAGE_START, STREAM_BUFFER_IDLE_BYTE, UBX_SYNC_CHAR_1);
+
+    if(length < scan_size){
+        unsigned char delimiter = stream_buffer->buffer[start + length];
+
+        if(delimiter == MESSAGE_END){
+            stream_buffer->tail = (start + length + 1) & STREAM_RING_BUFFER_MASK;
+            M10GnssDriverDispatchSentence(parser, (const char*)&stream_buffer->buffer[start], length);
+            return;
+        }
+
+        if(delimiter == MESSAGE_START || delimiter == UBX_SYNC_CHAR_1){
+            stream_buffer->tail = start + length;
+            return;
+        }
+    }
+    else if(scan_size == NMEA_SENTENCE_MAX_SIZE){
+        // Too long for an NMEA sentence, sync was lost
+        stream_buffer->tail = (start + 1) & STREAM_RING_BUFFER_MASK;
+        return;
+    }
+
+    memcpy(parser->sentence_carry, &stream_buffer->buffer[start], length);
+    parser->sentence_carry_length = length;
+    stream_buffer->tail = (start + length) & STREAM_RING_BUFFER_MASK;
+}
+
+/**
+ * @internal 
+ * @brief Complete the sentence in the carry buffer with the data at the tail, up to its `\n`, skipping the 
+ * module's padding. Once complete, the sentence is parsed from the carry buffer.
+ * 
+ * @param parser: `m10_gnss_parser*` Parser context
+ * @endinternal 
+ */
+void M10GnssDriverAssembleSentence(m10_gnss_parser* parser){
+    m10_gnss_stream_buffer* stream_buffer = parser->stream_buffer;
+    uint16_t start = stream_buffer->tail;
+    uint16_t head = stream_buffer->head;
+    uint16_t limit = (head >= start)?head:STREAM_RING_BUFFER_SIZE;
+    uint16_t room = NMEA_SENTENCE_MAX_SIZE - parser->sentence_carry_length;
+    uint16_t scan_size = (limit - start > room)?room:limit - start;
+    uint16_t length = NmeaScanDelimiters(&stream_buffer->buffer[start], scan_size, MESSAGE_END, MESSAGE_START, STREAM_BUFFER_IDLE_BYTE, UBX_SYNC_CHAR_1);
+
+    memcpy(&parser->sentence_carry[parser->sentence_carry_length], &stream_buffer->buffer[start], length);
+    parser->sentence_carry_length += length;
+    stream_buffer->tail = (start + length) & STREAM_RING_BUFFER_MASK;
+
+    if(length == scan_size){
+        // Too long for an NMEA sentence, sync was lost
+        if(scan_size == room)
+            parser->sentence_carry_length = 0;
+
+        return;
+    }
+
+    switch(stream_buffer->buffer[start + length]){
+
+        case MESSAGE_END:
+            STREAM_BUFFER_ADVANCE(stream_buffer);
+            M10GnssDriverDispatchSentence(parser, parser->sentence_carry, parser->sentence_carry_length);
+            parser->sentence_carry_length = 0;
+            break;
+
+        case MESSAGE_START:
+        case UBX_SYNC_CHAR_1:
+            // The rest of the sentence was lost, start over from the new frame
+            parser->sentence_carry_length = 0;
+            break;
+
+        default:
+            STREAM_BUFFER_ADVANCE(stream_buffer);
+            break;
+    }
+}
+
+/**
+ * @internal 
+ * @brief Frame the UBX frame starting at the tail (on its first sync character), from the length in its header.
+ *    In the common case the whole frame is already in the ring buffer, contiguous, and it is parsed in place.
+ * Otherwise its first byte is moved to the UBX carry buffer, to be completed by `M10GnssDriverAssembleUbxFrame`.
+ * A header without the second sync character, or with a length over UBX_FRAME_SKIP_MAX_SIZE, is not a frame:
+ * only the first byte is dropped, and the scan resumes right after it.
+ * 
+ * @param parser: `m10_gnss_parser*` Parser context
+ * @endinternal 
+ */
+void M10GnssDriverFrameUbxFrame(m10_gnss_parser* parser){
+    m10_gnss_stream_buffer* stream_buffer = parser->stream_buffer;
+    uint16_t start = stream_buffer->tail;
+    uint16_t head = stream_buffer->head;
+    uint16_t limit = (head >= start)?head:STREAM_RING_BUFFER_SIZE;
+    const uint8_t* header = &stream_buffer->buffer[start];
+
+    if(limit - start >= UBX_HEADER_SIZE){
+
+        if(header[1] != UBX_SYNC_CHAR_2 || UBX_U2(header, 4) > UBX_FRAME_SKIP_MAX_SIZE - UBX_FRAME_OVERHEAD){
+            STREAM_BUFFER_ADVANCE(stream_buffer);
+            return;
+        }
+
+        uint16_t length = UbxGetFrameLength(header);
+        if(length <= limit - start){
+            stream_buffer->tail = (start + length) & STREAM_RING_BUFFER_MASK;
+            M10GnssDriverParseUbxFrame(parser, header, length);
+            return;
+        }
+    }
+
+    parser->ubx_carry[0] = UBX_SYNC_CHAR_1;
+    parser->ubx_carry_length = 1;
+    parser->ubx_frame_length = 0;
+    STREAM_BUFFER_ADVANCE(stream_buffer);
+}
+
+/**
+ * @internal 
+ * @brief Complete the UBX frame in the carry buffer with the data at the tail. The header is completed a byte
+ * at a time and checked as in `M10GnssDriverFrameUbxFrame`, then the rest of the frame is copied a contiguous
+ * block at a time, and parsed from the carry buffer once complete.
+ *    A frame longer than UBX_FRAME_MAX_SIZE is not copied, only skipped by its length, so the data after it is
+ * framed again without looking for a `$`. Unlike in a sentence, `0xFF` is valid data in a frame, so padding in
+ * the middle of one is not skipped (the frame is then dropped by its checksum).
+ * 
+ * @param parser: `m10_gnss_parser*` Parser context
+ * @endinternal 
+ */
+void M10GnssDriverAssembleUbxFrame(m10_gnss_parser* parser){
+    m10_gnss_stream_buffer* stream_buffer = parser->stream_buffer;
+    uint16_t start = stream_buffer->tail;
+    uint16_t head = stream_buffer->head;
+    uint16_t limit = (head >= start)?head:STREAM_RING_BUFFER_SIZE;
+    uint16_t size;
+
+    if(parser->ubx_frame_length == 0){
+        unsigned char byte = stream_buffer->buffer[start];
+
+        if(parser->ubx_carry_length == 1 && byte != UBX_SYNC_CHAR_2){
+            // Not a frame, the scan resumes from this byte
+            parser->ubx_carry_length = 0;
+            return;
+        }
+
+        parser->ubx_carry[parser->ubx_carry_length++] = byte;
+        STREAM_BUFFER_ADVANCE(stream_buffer);
+
+        if(parser->ubx_carry_length < UBX_HEADER_SIZE)
+            return;
+
+        if(UBX_U2(parser->ubx_carry, 4) > UBX_FRAME_SKIP_MAX_SIZE - UBX_FRAME_OVERHEAD)
+            parser->ubx_carry_length = 0;
+        else
+            parser->ubx_frame_length = UbxGetFrameLength(parser->ubx_carry);
+
+        return;
+    }
+
+    size = parser->ubx_frame_length - parser->ubx_carry_length;
+    if(size > limit - start)
+        size = limit - start;
+
+    if(parser->ubx_frame_length <= UBX_FRAME_MAX_SIZE)
+        memcpy(&parser->ubx_carry[parser->ubx_carry_length], &stream_buffer->buffer[start], size);
+
+    parser->ubx_carry_length += size;
+    stream_buffer->tail = (start + size) & STREAM_RING_BUFFER_MASK;
+
+    if(parser->ubx_carry_length < parser->ubx_frame_length)
+        return;
+
+    if(parser->ubx_frame_length <= UBX_FRAME_MAX_SIZE)
+        M10GnssDriverParseUbxFrame(parser, parser->ubx_carry, parser->ubx_frame_length);
+
+    parser->ubx_carry_length = 0;
+    parser->ubx_frame_length = 0;
+}
+
+/**
+ * @internal 
+ * @brief Parse the data streamed from the module, one complete NMEA sentence or UBX frame at a time.
+ *    Everything outside of a frame is skipped up to the next `$` or UBX sync character, and each frame is handed
+ * to its own parser: sentences end on their `\n`, and UBX frames on the length in their header, so the binary
+ * data of a frame is never scanned for a delimiter. Frames are framed in place, and only the start of a frame
+ * that is not complete yet is kept across reads, in the carry buffers, so the parsing functions always get whole
+ * frames and never have to resume.
+ *    All the state is in the parser context, so different contexts can be parsed at the same time.
+ * 
+ * @param parser: `m10_gnss_parser*` Parser context
+ * @endinternal 
+ */
+void M10GnssDriverParseBuffer(m10_gnss_parser* parser){
+    m10_gnss_stream_buffer* stream_buffer = parser->stream_buffer;
+
+    while(!STREAM_BUFFER_IS_EMPTY(stream_buffer)){
+
+        if(parser->sentence_carry_length > 0){
+            M10GnssDriverAssembleSentence(parser);
+            continue;
+        }
+
+        if(parser->ubx_carry_length > 0){
+            M10GnssDriverAssembleUbxFrame(parser);
+            continue;
+        }
+
+        if(!M10GnssDriverSkipToFrameStart(parser))
+            return;
+
+        if(STREAM_BUFFER_PEEK(stream_buffer) == MESSAGE_START)
+            M10GnssDriverFrameSentence(parser);
+        else
+            M10GnssDriverFrameUbxFrame(parser);
+    }
+    
+}
+
+/**
+ * @internal 
+ * @brief Parse the data currently held in the ring buffer, if any.
+ * 
+ * @endinternal 
+ */
+void M10GnssDriverProcessStreamBuffer(void){
+
+    if(STREAM_BUFFER_IS_EMPTY(raw_stream_buffer))
+        return;
+
+    M10GnssDriverParseBuffer(&stream_parser);
+}
+
+/**
+ * @internal 
+ * @brief Check if a DMA stream buffer transfer (or chain of transfers) is still in progress.
+ * 
+ * @return char `1` if in progress, `0` otherwise
+ * @endinternal 
+ */
+char M10GnssDriverIsTransferInProgress(void){
+    return raw_stream_buffer_transfer_state == TRANSFER_IN_PROGRESS;
+}
+
+/**
+ * @internal 
+ * @brief Get a numeric measurement as an integer scaled by `GNSS_NUMERIC_SCALE`.
+ * 
+ * @param measurement: `const gnss_numeric_measurement*` Measurement
+ * @return int32_t Value x `GNSS_NUMERIC_SCALE`
+ * @endinternal 
+ */
+int32_t M10GnssDriverGetNumericScaled(const gnss_numeric_measurement* measurement){
+#ifdef M10_GNSS_FIXED_POINT
+    return measurement->value;
+#else
+    return (int32_t)(measurement->value * GNSS_NUMERIC_SCALE + ((measurement->value < 0)?-0.5:0.5));
+#endif
+}
+
+/**
+ * @internal 
+ * @brief Get the seconds of a time as an integer scaled by `GNSS_SECOND_SCALE`.
+ * 
+ * @param date_time: `const utc_date_time*` Date and time
+ * @return uint16_t Seconds x `GNSS_SECOND_SCALE`
+ * @endinternal 
+ */
+uint16_t M10GnssDriverGetSecondScaled(const utc_date_time* date_time){
+#ifdef M10_GNSS_FIXED_POINT
+    return date_time->second;
+#else
+    return (uint16_t)(date_time->second * GNSS_SECOND_SCALE + 0.5f);
+#endif
+}
+
+#ifdef M10_GNSS_FLOAT_ACCESSORS
+/**
+ * @internal 
+ * @brief Get a numeric measurement as a double.
+ * 
+ * @param measurement: `const gnss_numeric_measurement*` Measurement
+ * @return double Value
+ * @endinternal 
+ */
+double M10GnssDriverGetNumeric(const gnss_numeric_measurement* measurement){
+#ifdef M10_GNSS_FIXED_POINT
+    return (double)measurement->value / GNSS_NUMERIC_SCALE;
+#else
+    return measurement->value;
+#endif
+}
+
+/**
+ * @internal 
+ * @brief Get the seconds of a time as a float.
+ * 
+ * @param date_time: `const utc_date_time*` Date and time
+ * @return float Seconds
+ * @endinternal 
+ */
+float M10GnssDriverGetSecond(const utc_date_time* date_time){
+#ifdef M10_GNSS_FIXED_POINT
+    return (float)date_time->second / GNSS_SECOND_SCALE;
+#else
+    return date_time->second;
+#endif
+}
+
+/**
+ * @internal 
+ * @brief Get the whole degrees of a latitude or longitude, without its sign.
+ * 
+ * @param lat_long_measurement: `const gnss_lat_long_measurement*` Latitude or longitude
+ * @return int Degrees
+ * @endinternal 
+ */
+int M10GnssDriverGetLatLongDegrees(const gnss_lat_long_measurement* lat_long_measurement){
+    uint32_t magnitude = (lat_long_measurement->value < 0)?-(uint32_t)lat_long_measurement->value:(uint32_t)lat_long_measurement->value;
+
+    return magnitude / GNSS_LAT_LONG_SCALE;
+}
+
+/**
+ * @internal 
+ * @brief Get the minutes of a latitude or longitude, without its sign.
+ * 
+ * @param lat_long_measurement: `const gnss_lat_long_measurement*` Latitude or longitude
+ * @return float Minutes
+ * @endinternal 
+ */
+float M10GnssDriverGetLatLongMinutes(const gnss_lat_long_measurement* lat_long_measurement){
+    uint32_t magnitude = (lat_long_measurement->value < 0)?-(uint32_t)lat_long_measurement->value:(uint32_t)lat_long_measurement->value;
+
+    // 1e-7 degrees to 1e-6 minutes: x 60 / 10
+    return (magnitude % GNSS_LAT_LONG_SCALE) * 6 / 1000000.0f;
+}
+#endif
+
+/**
+ * @internal 
+ * @brief Get the number of sentences dropped by the parser since initialization.
+ * 
+ * @return const m10_gnss_reject_count* Pointer to the counters of each sentence type
+ * @endinternal 
+ */
+const m10_gnss_reject_count* M10GnssDriverGetRejectCount(void){
+    return &stream_parser.reject_count;
+}
+
+/**
+ * @internal 
+ * @brief Select the sentence types decoded by the driver's parser.
+ * 
+ * @param subscriptions: `uint32_t` `M10_GNSS_SUBSCRIBE` of each sentence type to be decoded
+ * @endinternal 
+ */
+void M10GnssDriverSetSubscriptions(uint32_t subscriptions){
+    stream_parser.subscriptions = subscriptions;
+}
+
+/**
+ * @internal 
+ * @brief Get the satellites in view of a constellation, from the last complete `GSV` groups.
+ * 
+ * @param constellation: `gnss_constellation` Constellation
+ * @return const gnss_satellite_table* Pointer to the satellite table
+ * @endinternal 
+ */
+const gnss_satellite_table* M10GnssDriverGetSatellites(gnss_constellation constellation){
+    return &stream_parser.satellites[constellation];
+}
+
+/**
+ * @internal 
+ * @brief Get the number of sentence characters decoded and skipped by the driver's parser since initialization.
+ * 
+ * @return const m10_gnss_sentence_bytes* Array with the counters of each `m10_gnss_sentence_type`
+ * @endinternal 
+ */
+const m10_gnss_sentence_bytes* M10GnssDriverGetSentenceBytes(void){
+    return stream_parser.sentence_bytes;
+}
+
+/**
+ * @internal 
+ * @brief Check if the parser stopped in the middle of a message.
+ * 
+ * @return char `1` if a message is partially parsed, `0` otherwise
+ * @endinternal 
+ */
+char M10GnssDriverIsParsingMessage(void){
+    return stream_parser.sentence_carry_length > 0 || stream_parser.ubx_carry_length > 0;
+}
+
+/**
+ * @internal 
+ * @brief Read and parse the data on the module's stream buffer using DMA.
+ *    If no transfer is in progress, a new drain is started into the free region of the ring buffer, and then 
+ * whatever was already committed is parsed while the DMA runs. This way the time per call is roughly the 
+ * largest of bus time and parse time, instead of their sum.
+ *    A sentence split between two transfers is kept in the carry buffer until the rest of it arrives.
+ * 
+ * @endinternal 
+ */
+void M10GnssDriverReadDataDma(void){
+
+    if(raw_stream_buffer_transfer_state == TRANSFER_IDLE && M10GnssDriverIsReadTriggered()){
+        M10GnssDriverQueryPendingBytes();
+        M10GnssDriverStartStreamBufferTransfer();
+    }
+
+    M10GnssDriverProcessStreamBuffer();
+}
+
+/**
+ * @internal 
+ * @brief Read and parse the data on the module's stream buffer.
+ *    With `BLOCKING_ACQUISITION` the whole read and parse happens in this call, with `DMA_ACQUISITION`
+ * each call starts the next transfer (if none is in progress) and parses the data received so far. Transports
+ * without `read_async` are always read in blocking mode.
+ *    With `TX_READY_TRIGGER` the module is only accessed after it signals data through the TX-ready pin, so 
+ * calls with nothing to read do not touch the bus.
+ * 
+ * @endinternal 
+ */
+void M10GnssDriverReadData(void){
+
+    if(m10_gnss_module->acquisition_mode == DMA_ACQUISITION && m10_gnss_module->transport.read_async != NULL){
+        M10GnssDriverReadDataDma();
+        return;
+    }
+
+    if(M10GnssDriverIsReadTriggered())
+        M10GnssDriverReadStreamBuffer();
+
+    M10GnssDriverProcessStreamBuffer();
+    
+}
+
+/**
+ * @internal 
+ * @brief Get the constellation of a `GSV` message from its talker.
+ * 
+ * @param nmea_origin_id: `nmea_caller_id*` Address field of the message
+ * @return gnss_constellation `NUM_GNSS_CONSTELLATIONS` if the talker is not a constellation
+ * @endinternal 
+ */
+gnss_constellation M10GnssDriverGetConstellation(nmea_caller_id* nmea_origin_id){
+    if((*nmea_origin_id)[0] != 'G')
+        return NUM_GNSS_CONSTELLATIONS;
+
+    switch((*nmea_origin_id)[1]){
+        case 'P': return GPS_CONSTELLATION;
+        case 'L': return GLONASS_CONSTELLATION;
+        case 'A': return GALILEO_CONSTELLATION;
+        case 'B': return BEIDOU_CONSTELLATION;
+        case 'I': return NAVIC_CONSTELLATION;
+        case 'Q': return QZSS_CONSTELLATION;
+        default: return NUM_GNSS_CONSTELLATIONS;
+    }
+}
+
+/**
+ * @internal 
+ * @brief Decode the fields of a `GSV` message after its header: up to 4 satellites (ID, elevation, azimuth and
+ * SNR, where empty values mean not known / not tracked) followed by the signal ID (NMEA 4.10 and newer).
+ * 
+ * @param sentence: `nmea_sentence*` Sentence positioned after the number of satellites in view
+ * @param satellites: `gsv_satellite*` Array of `GSV_SATELLITES_PER_MESSAGE` satellites to be filled
+ * @param num_satellites: `uint8_t*` Number of satellites in the message
+ * @param signal_id: `uint8_t*` Signal ID, left unchanged if the message has none
+ * @return char `1` if the fields are well formed, `0` otherwise
+ * @endinternal 
+ */
+char M10GnssDriverDecodeGsvSatellites(nmea_sentence* sentence, gsv_satellite* satellites, uint8_t* num_satellites, uint8_t* signal_id){
+    nmea_field_span field = {.field_status = VALID};
+    int32_t value;
+
+    *num_satellites = 0;
+    for(unsigned char column = 0; field.field_status != END_OF_MESSAGE; column = (column + 1) % GSV_SATELLITE_FIELDS){
+        gsv_satellite* satellite = &satellites[*num_satellites];
+        field = NmeaGetNextField(sentence);
+
+        switch(column){
+            case 0:
+                // The last field, where the next satellite would start, is the signal ID
+                if(field.field_status == END_OF_MESSAGE){
+                    int signal = (field.length == 1)?NmeaParseHexDigit(field.data[0]):-1;
+                    if(signal < 0)
+                        return 0;
+
+                    *signal_id = signal;
+                    break;
+                }
+
+                if(*num_satellites == GSV_SATELLITES_PER_MESSAGE || !NmeaParseDecimal(&field, 0, &value) || value < 1 || value > UINT8_MAX)
+                    return 0;
+
+                satellite->prn = value;
+                break;
+
+            case 1:
+                if(field.field_status == END_OF_MESSAGE)
+                    return 0;
+
+                if(field.field_status == EMPTY)
+                    satellite->elevation = GNSS_ELEVATION_UNKNOWN;
+                else if(NmeaParseDecimal(&field, 0, &value) && value >= -90 && value <= 90)
+                    satellite->elevation = value;
+                else
+                    return 0;
+                break;
+
+            case 2:
+                if(field.field_status == END_OF_MESSAGE)
+                    return 0;
+
+                if(field.field_status == EMPTY)
+                    satellite->azimuth = GNSS_AZIMUTH_UNKNOWN;
+                else if(NmeaParseDecimal(&field, 0, &value) && value >= 0 && value < 360)
+                    satellite->azimuth = value;
+                else
+                    return 0;
+                break;
+
+            default:
+                if(field.length == 0)
+                    satellite->snr = 0;
+                else if(NmeaParseDecimal(&field, 0, &value) && value >= 0 && value <= UINT8_MAX)
+                    satellite->snr = value;
+                else
+                    return 0;
+
+                (*num_satellites)++;
+                break;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * @internal 
+ * @brief Parse a `GSV` message into the satellite table of its constellation, without buffering the group of
+ * messages: the satellites of each message are added to the table of the group in progress as soon as its
+ * checksum is verified, and once the last message of the group is received, the table is published with the epoch
+ * (see `M10GnssDriverCommitEpoch`). A group with a missing or rejected message is dropped.
+ *    Each signal ID is sent as its own group, so a new cycle (and an empty table) starts when the first message of
+ * a group arrives for a signal ID that already has a group in the table.
+ * 
+ * @param parser: `m10_gnss_parser*` Parser context
+ * @param nmea_origin_id: `nmea_caller_id*` Address field of the message
+ * @param sentence: `nmea_sentence*` Sentence positioned on its first data field
+ * @endinternal 
+ */
+void M10GnssDriverGsvParser(m10_gnss_parser* parser, nmea_caller_id* nmea_origin_id, nmea_sentence* sentence){
+    gnss_constellation constellation = M10GnssDriverGetConstellation(nmea_origin_id);
+    gsv_satellite satellites[GSV_SATELLITES_PER_MESSAGE];
+    uint8_t num_satellites = 0;
+    uint8_t signal_id = 0;
+    int32_t num_messages = 0;
+    int32_t message = 0;
+    char is_well_formed;
+
+    if(constellation == NUM_GNSS_CONSTELLATIONS)
+        return;
+
+    m10_gnss_gsv_group* group = &parser->gsv_groups[constellation];
+    gnss_satellite_table* table = &group->satellites;
+
+    nmea_field_span field = NmeaGetNextField(sentence);
+    is_well_formed = NmeaParseDecimal(&field, 0, &num_messages);
+    field = NmeaGetNextField(sentence);
+    is_well_formed = is_well_formed && NmeaParseDecimal(&field, 0, &message) && message >= 1 && message <= num_messages;
+    // Number of satellites in view, not needed as they are counted from the table
+    field = NmeaGetNextField(sentence);
+    is_well_formed = is_well_formed && (field.field_status == END_OF_MESSAGE || 
+                     M10GnssDriverDecodeGsvSatellites(sentence, satellites, &num_satellites, &signal_id));
+
+    if(!is_well_formed || !NmeaIsChecksumValid(sentence)){
+        parser->reject_count.gsv++;
+        message = 0;
+    }
+    else if(!M10GnssDriverJoinEpoch(parser, EPOCH_SOURCE_NMEA, EPOCH_KEY_UNKNOWN))  // Only a valid message joins an epoch
+        return;
+
+    if(message == 1){
+        if(group->next_message != 0)
+            table->count = group->first_entry;
+
+        if((group->signals & (1 << signal_id)) || group->is_from_ubx){
+            // The groups of the previous cycle were not committed yet, when the epoch is not closed by other sentences.
+            // A table replaced by UBX-NAV-SAT is in the same epoch as the GSV groups that follow it.
+            if(!group->is_from_ubx && (parser->epoch_constellations & (1 << constellation)))
+                M10GnssDriverStartEpoch(parser, EPOCH_SOURCE_NMEA, EPOCH_KEY_UNKNOWN);
+
+            table->count = 0;
+            group->signals = 0;
+            group->is_from_ubx = 0;
+        }
+
+        group->first_entry = table->count;
+        group->next_message = 1;
+        group->num_messages = num_messages;
+        group->signal_id = signal_id;
+    }
+
+    if(message == 0 || message != group->next_message || num_messages != group->num_messages || signal_id != group->signal_id){
+        // Drop the satellites of the group in progress, which misses a message
+        if(group->next_message != 0)
+            table->count = group->first_entry;
+
+        group->next_message = 0;
+        return;
+    }
+
+    for(uint8_t satellite = 0; satellite < num_satellites && table->count < GNSS_SATELLITE_TABLE_SIZE; satellite++){
+        table->prn[table->count] = satellites[satellite].prn;
+        table->elevation[table->count] = satellites[satellite].elevation;
+        table->azimuth[table->count] = satellites[satellite].azimuth;
+        table->snr[table->count] = satellites[satellite].snr;
+        table->signal_id[table->count] = signal_id;
+        table->count++;
+    }
+
+    if(message < num_messages){
+        group->next_message++;
+        return;
+    }
+
+    group->next_message = 0;
+    group->signals |= 1 << signal_id;
+    parser->epoch_constellations |= 1 << constellation;
+    parser->epoch_pending = 1;
+}
+
+/**
+ * @internal 
+ * @brief Get the epoch key of a `UBX-NAV` message, its UTC time of day in milliseconds.
+ *    Only `UBX-NAV-PVT` has a UTC time, the other messages only have the GPS time of week: the offset between both,
+ * learnt from the last PVT with a valid time, gives the key of the whole epoch whichever message comes first.
+ * 
+ * @param parser: `m10_gnss_parser*` Parser context
+ * @param ubx: `const ubx_frame*` Valid `UBX-NAV` frame
+ * @param time_of_week: `uint32_t` GPS time of week of the frame, in ms
+ * @return uint32_t Epoch key, `EPOCH_KEY_UNKNOWN` until a PVT with a valid time was received
+ * @endinternal 
+ */
+uint32_t M10GnssDriverGetUbxEpochKey(m10_gnss_parser* parser, const ubx_frame* ubx, uint32_t time_of_week){
+    uint32_t time_of_day;
+
+    if(UbxGetUtcTimeOfDay(ubx, &time_of_day))
+        parser->ubx_utc_offset = (time_of_week % GNSS_MS_PER_DAY + GNSS_MS_PER_DAY - time_of_day) % GNSS_MS_PER_DAY;
+
+    if(time_of_week != parser->ubx_time_of_week || parser->ubx_epoch_key == EPOCH_KEY_UNKNOWN){
+        parser->ubx_time_of_week = time_of_week;
+        parser->ubx_epoch_key = (parser->ubx_utc_offset == EPOCH_KEY_UNKNOWN)? EPOCH_KEY_UNKNOWN :
+                                (time_of_week % GNSS_MS_PER_DAY + GNSS_MS_PER_DAY - parser->ubx_utc_offset) % GNSS_MS_PER_DAY;
+    }
+
+    return parser->ubx_epoch_key;
+}
+
+/**
+ * @internal 
+ * @brief Parse a complete UBX frame into the context's epoch.
+ *    The messages are keyed by their UTC time like the NMEA sentences, so a message of another epoch commits the
+ * previous one when its `UBX-NAV-EOE` was lost, and the messages of an epoch that the NMEA sentences already
+ * committed are dropped. A `UBX-NAV-SAT` frame replaces the satellite tables of all the constellations at once,
+ * and the next GSV group of each constellation replaces them in turn.
+ * 
+ * @param parser: `m10_gnss_parser*` Parser context
+ * @param frame: `const uint8_t*` First sync character of the frame, in contiguous memory
+ * @param frame_size: `uint16_t` Number of bytes of the frame, header and checksum included
+ * @endinternal 
+ */
+void M10GnssDriverParseUbxFrame(m10_gnss_parser* parser, const uint8_t* frame, uint16_t frame_size){
+    ubx_frame ubx = {.data = frame, .length = frame_size};
+    uint32_t time_of_week;
+    char is_decoded = 1;
+
+    if(!UbxIsFrameValid(&ubx)){
+        parser->reject_count.ubx++;
+        return;
+    }
+
+    if(UBX_FRAME_CLASS(&ubx) != UBX_CLASS_NAV || UBX_FRAME_PAYLOAD_SIZE(&ubx) < sizeof(time_of_week))
+        return;
+
+    time_of_week = UbxGetTimeOfWeek(&ubx);
+    if(!M10GnssDriverJoinEpoch(parser, EPOCH_SOURCE_UBX, M10GnssDriverGetUbxEpochKey(parser, &ubx, time_of_week))){
+        if(UBX_FRAME_ID(&ubx) == UBX_ID_NAV_EOE)
+            M10GnssDriverEndEpoch(parser, EPOCH_SOURCE_UBX);
+        return;
+    }
+
+    switch(UBX_FRAME_ID(&ubx)){
+        case UBX_ID_NAV_PVT:
+            is_decoded = UbxParseNavPvt(&ubx, &parser->epoch_record);
+            parser->epoch_pending |= is_decoded;
+            break;
+
+        case UBX_ID_NAV_DOP:
+            is_decoded = UbxParseNavDop(&ubx, &parser->epoch_record);
+            parser->epoch_pending |= is_decoded;
+            break;
+
+        case UBX_ID_NAV_SAT:
+            for(gnss_constellation constellation = 0; constellation < NUM_GNSS_CONSTELLATIONS; constellation++){
+                m10_gnss_gsv_group* group = &parser->gsv_groups[constellation];
+
+                // The payload size is checked with the first constellation, before anything is written
+                is_decoded = UbxParseNavSat(&ubx, constellation, &group->satellites);
+                if(!is_decoded)
+                    break;
+
+                // The next GSV group starts a new table, instead of adding to this one
+                group->next_message = 0;
+                group->signals = 0;
+                group->is_from_ubx = 1;
+                parser->epoch_constellations |= 1 << constellation;
+            }
+            parser->epoch_pending |= is_decoded;
+            break;
+
+        case UBX_ID_NAV_EOE:
+            M10GnssDriverEndEpoch(parser, EPOCH_SOURCE_UBX);
+            break;
+
+        default:
+            break;
+    }
+
+    if(!is_decoded)
+        parser->reject_count.ubx++;
 }
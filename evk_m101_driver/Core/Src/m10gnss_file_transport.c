@@ -0,0 +1,93 @@
+#ifdef M10_GNSS_HOST_FILE_TRANSPORT
+
+#include <stdio.h>
+
+#include "m10gnss_file_transport.h"
+
+/**
+ * @internal
+ * @brief Host side transport over a recorded log. As with `tests/m10gnss_fake_transport.c`, the only other HAL call made
+ * by the driver (`HAL_GPIO_ReadPin`, for the TX-ready pin) is replaced here, reporting the pin as asserted while
+ * there are bytes left in the log, so both can not be compiled together.
+ *
+ * @endinternal
+ */
+FILE* file_transport_file = NULL;
+long file_transport_size = 0;
+
+/**
+ * @internal
+ * @brief Open the log and get its size, so the bytes available can be computed without touching the file. A log
+ * still open (e.g. when the driver is initialized again) is closed first.
+ *
+ * @endinternal
+ */
+HAL_StatusTypeDef M10GnssFileTransportOpen(m10_gnss_transport* transport){
+        M10GnssFileTransportClose(transport);
+
+        file_transport_file = fopen((const char*)transport->handle, "rb");
+        if(file_transport_file == NULL)
+            return HAL_ERROR;
+
+        fseek(file_transport_file, 0, SEEK_END);
+        file_transport_size = ftell(file_transport_file);
+        fseek(file_transport_file, 0, SEEK_SET);
+        return HAL_OK;
+}
+
+/**
+ * @internal
+ * @brief Get the number of bytes left in the log, capped to 65535.
+ *
+ * @endinternal
+ */
+uint16_t M10GnssFileTransportBytesAvailable(m10_gnss_transport* transport){
+        long remaining;
+
+        UNUSED(transport);
+
+        if(file_transport_file == NULL)
+            return 0;
+
+        remaining = file_transport_size - ftell(file_transport_file);
+        return (remaining > 0xFFFF)? 0xFFFF : (uint16_t)remaining;
+}
+
+/**
+ * @internal
+ * @brief Read the next bytes of the log.
+ *
+ * @endinternal
+ */
+HAL_StatusTypeDef M10GnssFileTransportRead(m10_gnss_transport* transport, uint8_t* data, uint16_t data_size){
+        UNUSED(transport);
+
+        if(file_transport_file == NULL || fread(data, 1, data_size, file_transport_file) != data_size)
+            return HAL_ERROR;
+
+        return HAL_OK;
+}
+
+/**
+ * @internal
+ * @brief Close the log, after which no bytes are available.
+ *
+ * @endinternal
+ */
+void M10GnssFileTransportClose(m10_gnss_transport* transport){
+        UNUSED(transport);
+
+        if(file_transport_file != NULL)
+            fclose(file_transport_file);
+
+        file_transport_file = NULL;
+        file_transport_size = 0;
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin){
+    UNUSED(GPIOx);
+    UNUSED(GPIO_Pin);
+    return (M10GnssFileTransportBytesAvailable(NULL) > 0)? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+#endif
@@ -0,0 +1,144 @@
+#include "m10gnss_i2c_transport.h"
+#ifdef M10_GNSS_LL_I2C
+#include "m10gnss_ll_i2c.h"
+#endif
+
+#define I2C_TRANSPORT_TIMEOUT 10000  // Timeout of the blocking HAL calls, in ms
+
+#ifdef M10_GNSS_I2C_CYCLE_COUNT
+m10_gnss_i2c_cycle_count i2c_cycle_count;
+
+/**
+ * @internal
+ * @brief Get the number of CPU cycles since the HAL tick started counting.
+ *    The Cortex-M0+ has no cycle counter (DWT), so it is built from the millisecond tick and the SysTick down
+ * counter, re-reading the tick in case SysTick reloaded in between.
+ *
+ * @return uint32_t Cycle timestamp, only meaningful as a difference between two timestamps
+ * @endinternal
+ */
+uint32_t M10GnssI2cTransportGetCycles(void){
+    uint32_t tick;
+    uint32_t counter;
+
+    do{
+        tick = HAL_GetTick();
+        counter = SysTick->VAL;
+    } while(tick != HAL_GetTick());
+
+    return tick * (SysTick->LOAD + 1) + (SysTick->LOAD - counter);
+}
+
+/**
+ * @internal
+ * @brief Account a register read in its cycle count.
+ *
+ * @param cycle_count: `m10_gnss_cycle_count*` Cycle count of the kind of read
+ * @param cycles: `uint32_t` Cycles spent in the read
+ * @param data_size: `uint16_t` Bytes read
+ * @endinternal
+ */
+void M10GnssI2cTransportCountCycles(m10_gnss_cycle_count* cycle_count, uint32_t cycles, uint16_t data_size){
+    cycle_count->last = cycles;
+    cycle_count->max = (cycles > cycle_count->max)?cycles:cycle_count->max;
+    cycle_count->total += cycles;
+    cycle_count->bytes += data_size;
+    cycle_count->transactions++;
+}
+
+const m10_gnss_i2c_cycle_count* M10GnssI2cTransportGetCycleCount(void){
+    return &i2c_cycle_count;
+}
+#endif
+
+/**
+ * @internal
+ * @brief Blocking read of consecutive module registers, through the HAL or, when `M10_GNSS_LL_I2C` is defined,
+ * straight through the I2C registers (see `m10gnss_ll_i2c.c`). DMA transfers always go through the HAL.
+ *    With `M10_GNSS_I2C_CYCLE_COUNT` defined, the CPU cycles of every read are accounted in `i2c_cycle_count`.
+ *
+ * @param transport: `m10_gnss_transport*` I2C transport
+ * @param register_address: `uint8_t` Address of the first register to be read
+ * @param data: `uint8_t*` Pointer to hold the read bytes
+ * @param data_size: `uint16_t` Number of bytes to read
+ * @return HAL_StatusTypeDef `HAL_OK` if the read succeeded
+ * @endinternal
+ */
+HAL_StatusTypeDef M10GnssI2cTransportRegisterRead(m10_gnss_transport* transport, uint8_t register_address, uint8_t* data, uint16_t data_size){
+        HAL_StatusTypeDef status;
+#ifdef M10_GNSS_I2C_CYCLE_COUNT
+        uint32_t start_cycles = M10GnssI2cTransportGetCycles();
+#endif
+
+#ifdef M10_GNSS_LL_I2C
+        status = M10GnssLlI2cMemRead(((I2C_HandleTypeDef*)transport->handle)->Instance, transport->address, register_address, data, data_size);
+#else
+        status = HAL_I2C_Mem_Read(transport->handle, transport->address, register_address, STREAM_BUFFER_REGISTER_SIZE, data, data_size, I2C_TRANSPORT_TIMEOUT);
+#endif
+
+#ifdef M10_GNSS_I2C_CYCLE_COUNT
+        M10GnssI2cTransportCountCycles((register_address == STREAM_BUFFER_REGISTER)?&i2c_cycle_count.stream_read:&i2c_cycle_count.length_read, M10GnssI2cTransportGetCycles() - start_cycles, data_size);
+#endif
+        return status;
+}
+
+/**
+ * @internal
+ * @brief Nothing to prepare, the peripheral is initialized by `MX_I2Cx_Init`.
+ *
+ * @endinternal
+ */
+HAL_StatusTypeDef M10GnssI2cTransportOpen(m10_gnss_transport* transport){
+        UNUSED(transport);
+        return HAL_OK;
+}
+
+/**
+ * @internal
+ * @brief Gets the number of bytes in the module's stream buffer.
+ *    Both length registers (0xFD high byte and 0xFE low byte) are read in a single 2 byte burst, relying on the
+ * module's register address auto increment.
+ *
+ * @return uint16_t Number of bytes to be read in the buffer
+ * @endinternal
+ */
+uint16_t M10GnssI2cTransportBytesAvailable(m10_gnss_transport* transport){
+
+        unsigned char raw_buffer_size[2];
+
+        if(M10GnssI2cTransportRegisterRead(transport, AVAILABLE_BUFFER_HB, raw_buffer_size, 2) != HAL_OK)
+            return 0;
+
+        return (uint16_t)((raw_buffer_size[0] << 8) | raw_buffer_size[1]);
+}
+
+/**
+ * @internal
+ * @brief Blocking read of the module's stream buffer register.
+ *
+ * @endinternal
+ */
+HAL_StatusTypeDef M10GnssI2cTransportRead(m10_gnss_transport* transport, uint8_t* data, uint16_t data_size){
+        return M10GnssI2cTransportRegisterRead(transport, STREAM_BUFFER_REGISTER, data, data_size);
+}
+
+/**
+ * @internal
+ * @brief DMA read of the module's stream buffer register, signalled through `HAL_I2C_MemRxCpltCallback`.
+ *
+ * @endinternal
+ */
+HAL_StatusTypeDef M10GnssI2cTransportReadAsync(m10_gnss_transport* transport, uint8_t* data, uint16_t data_size){
+        return HAL_I2C_Mem_Read_DMA(transport->handle, transport->address, STREAM_BUFFER_REGISTER, STREAM_BUFFER_REGISTER_SIZE, data, data_size);
+}
+
+/**
+ * @internal
+ * @brief Blocking write of a message to the module, which takes any write without a register address as input
+ * to its message parser.
+ *
+ * @endinternal
+ */
+HAL_StatusTypeDef M10GnssI2cTransportWrite(m10_gnss_transport* transport, const uint8_t* data, uint16_t data_size){
+        return HAL_I2C_Master_Transmit(transport->handle, transport->address, (uint8_t*)data, data_size, I2C_TRANSPORT_TIMEOUT);
+}
@@ -0,0 +1,119 @@
+#ifdef M10_GNSS_LL_I2C
+
+#include "m10gnss_ll_i2c.h"
+#include "stm32g0xx_ll_i2c.h"
+
+#define LL_I2C_ERROR_FLAGS (I2C_ISR_NACKF | I2C_ISR_BERR | I2C_ISR_ARLO)
+#define LL_I2C_TRANSFER_CONFIG (I2C_CR2_SADD | I2C_CR2_HEAD10R | I2C_CR2_NBYTES | I2C_CR2_RELOAD | I2C_CR2_RD_WRN)
+
+/**
+ * @internal
+ * @brief Register level replacement of the blocking `HAL_I2C_Mem_Read` used to read the module's registers. Only
+ * compiled when `M10_GNSS_LL_I2C` is defined.
+ *    The HAL goes through its handle state machine, the handle lock and a `HAL_GetTick` based timeout on every
+ * flag it waits for, which at 16 MHz is a noticeable share of the short length register reads. Here every step
+ * is a plain poll of the ISR register, bounded by `LL_I2C_TIMEOUT_SPINS`, and the peripheral configuration
+ * (timing, filters, enable) is left to `MX_I2C1_Init`.
+ *
+ * @endinternal
+ */
+
+/**
+ * @internal
+ * @brief Wait until one of the flags in `flag` is set in the ISR register.
+ *
+ * @param i2c: `I2C_TypeDef*` I2C peripheral
+ * @param flag: `uint32_t` ISR flag(s) to wait for
+ * @return HAL_StatusTypeDef `HAL_OK` if set, `HAL_ERROR` if an error flag was set first, `HAL_TIMEOUT` otherwise
+ * @endinternal
+ */
+HAL_StatusTypeDef M10GnssLlI2cWaitFlag(I2C_TypeDef* i2c, uint32_t flag){
+
+    for(uint32_t spins = 0; spins < LL_I2C_TIMEOUT_SPINS; spins++){
+        uint32_t status = LL_I2C_ReadReg(i2c, ISR);
+
+        if(status & flag)
+            return HAL_OK;
+        if(status & LL_I2C_ERROR_FLAGS)
+            return HAL_ERROR;
+    }
+
+    return HAL_TIMEOUT;
+}
+
+/**
+ * @internal
+ * @brief Release the bus after a failed transfer, and leave the peripheral ready for the next one.
+ *    A NACK in software end mode, or a timeout, leaves the bus taken, so a STOP is generated before the flags
+ * are cleared.
+ *
+ * @param i2c: `I2C_TypeDef*` I2C peripheral
+ * @param status: `HAL_StatusTypeDef` Status of the failed step
+ * @return HAL_StatusTypeDef The `status` of the failed step
+ * @endinternal
+ */
+HAL_StatusTypeDef M10GnssLlI2cAbort(I2C_TypeDef* i2c, HAL_StatusTypeDef status){
+
+    if(LL_I2C_IsActiveFlag_BUSY(i2c) && !LL_I2C_IsActiveFlag_STOP(i2c)){
+        LL_I2C_GenerateStopCondition(i2c);
+        M10GnssLlI2cWaitFlag(i2c, I2C_ISR_STOPF);
+    }
+
+    LL_I2C_ClearFlag_STOP(i2c);
+    LL_I2C_ClearFlag_NACK(i2c);
+    LL_I2C_ClearFlag_BERR(i2c);
+    LL_I2C_ClearFlag_ARLO(i2c);
+    LL_I2C_ClearFlag_TXE(i2c);
+    CLEAR_BIT(i2c->CR2, LL_I2C_TRANSFER_CONFIG);
+
+    return status;
+}
+
+HAL_StatusTypeDef M10GnssLlI2cMemRead(I2C_TypeDef* i2c, uint16_t device_address, uint8_t register_address, uint8_t* data, uint16_t data_size){
+    HAL_StatusTypeDef status;
+    uint16_t block_size;
+
+    if(data_size == 0)
+        return HAL_OK;
+
+    // Register address write, in software end mode so the read follows with a repeated start
+    LL_I2C_HandleTransfer(i2c, device_address, LL_I2C_ADDRSLAVE_7BIT, 1, LL_I2C_MODE_SOFTEND, LL_I2C_GENERATE_START_WRITE);
+    if((status = M10GnssLlI2cWaitFlag(i2c, I2C_ISR_TXIS)) != HAL_OK)
+        return M10GnssLlI2cAbort(i2c, status);
+
+    LL_I2C_TransmitData8(i2c, register_address);
+    if((status = M10GnssLlI2cWaitFlag(i2c, I2C_ISR_TC)) != HAL_OK)
+        return M10GnssLlI2cAbort(i2c, status);
+
+    // Read in blocks of up to 255 bytes, the last one ending with an automatic STOP
+    block_size = (data_size > LL_I2C_MAX_RELOAD_SIZE)?LL_I2C_MAX_RELOAD_SIZE:data_size;
+    LL_I2C_HandleTransfer(i2c, device_address, LL_I2C_ADDRSLAVE_7BIT, block_size, (data_size > block_size)?LL_I2C_MODE_RELOAD:LL_I2C_MODE_AUTOEND, LL_I2C_GENERATE_START_READ);
+
+    while(1){
+        for(uint16_t i = 0; i < block_size; i++){
+            if((status = M10GnssLlI2cWaitFlag(i2c, I2C_ISR_RXNE)) != HAL_OK)
+                return M10GnssLlI2cAbort(i2c, status);
+
+            *data++ = LL_I2C_ReceiveData8(i2c);
+        }
+
+        data_size -= block_size;
+        if(data_size == 0)
+            break;
+
+        if((status = M10GnssLlI2cWaitFlag(i2c, I2C_ISR_TCR)) != HAL_OK)
+            return M10GnssLlI2cAbort(i2c, status);
+
+        block_size = (data_size > LL_I2C_MAX_RELOAD_SIZE)?LL_I2C_MAX_RELOAD_SIZE:data_size;
+        LL_I2C_HandleTransfer(i2c, device_address, LL_I2C_ADDRSLAVE_7BIT, block_size, (data_size > block_size)?LL_I2C_MODE_RELOAD:LL_I2C_MODE_AUTOEND, LL_I2C_GENERATE_NOSTARTSTOP);
+    }
+
+    if((status = M10GnssLlI2cWaitFlag(i2c, I2C_ISR_STOPF)) != HAL_OK)
+        return M10GnssLlI2cAbort(i2c, status);
+
+    LL_I2C_ClearFlag_STOP(i2c);
+    CLEAR_BIT(i2c->CR2, LL_I2C_TRANSFER_CONFIG);
+    return HAL_OK;
+}
+
+#endif
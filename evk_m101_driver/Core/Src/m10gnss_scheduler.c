@@ -0,0 +1,225 @@
+#include "m10gnss_scheduler.h"
+#include "m10gnss_driver.h"
+#include "tim.h"
+
+#define SCHEDULER_MIN_DELAY_MS 2  // Smallest delay the one pulse timer can be armed with (ARR = 1)
+
+m10_gnss_scheduler* m10_gnss_scheduler_instance = NULL;
+uint32_t scheduler_read_tick = 0;  // HAL tick at which the last read was started
+
+/**
+ * @internal
+ * @brief Arm the one pulse timer to expire after `delay_ms`, restarting it if it was already running.
+ *
+ * @param delay_ms: `uint32_t` Delay until the next read, clamped to the timer's 16 bit range
+ * @endinternal
+ */
+void M10GnssSchedulerArmTimer(uint32_t delay_ms){
+    TIM_HandleTypeDef* timer_handle = m10_gnss_scheduler_instance->timer_handle;
+
+    delay_ms = (delay_ms < SCHEDULER_MIN_DELAY_MS)? SCHEDULER_MIN_DELAY_MS : delay_ms;
+    delay_ms = (delay_ms > 0xFFFF)? 0xFFFF : delay_ms;
+
+    HAL_TIM_Base_Stop_IT(timer_handle);
+    __HAL_TIM_SET_AUTORELOAD(timer_handle, delay_ms - 1);
+    __HAL_TIM_SET_COUNTER(timer_handle, 0);
+    __HAL_TIM_CLEAR_FLAG(timer_handle, (uint32_t)TIM_FLAG_UPDATE);  // 32 bit complement, also on 64 bit hosts
+    HAL_TIM_Base_Start_IT(timer_handle);
+}
+
+/**
+ * @internal
+ * @brief Arm the timer for the next read: a fast poll while learning, or the expected end of the next epoch
+ * burst when locked. If the expected time already passed, the read happens as soon as possible.
+ *
+ * @endinternal
+ */
+void M10GnssSchedulerArmNextRead(void){
+    m10_gnss_scheduler* scheduler = m10_gnss_scheduler_instance;
+
+    if(scheduler->state == SCHEDULER_LEARNING){
+        M10GnssSchedulerArmTimer(SCHEDULER_LEARNING_POLL_MS);
+        return;
+    }
+
+    uint32_t target_tick = scheduler->last_utc_ms + scheduler->epoch_period_ms + scheduler->epoch_phase_offset_ms;
+    int32_t delay_ms = (int32_t)(target_tick - HAL_GetTick());
+    M10GnssSchedulerArmTimer((delay_ms < 0)? 0 : (uint32_t)delay_ms);
+}
+
+/**
+ * @internal
+ * @brief Learn the epoch period and output phase from the epochs observed while polling fast.
+ *    The period is the difference between the UTC time of consecutive epochs, and must be the same for
+ * `SCHEDULER_LEARNING_EPOCHS` epochs in a row. The phase is the smallest difference between the HAL tick at
+ * which an epoch was read and its UTC time, i.e the read closest to the moment the module output it. Once
+ * learned, `SCHEDULER_BURST_GUARD_MS` is added so the read happens after the whole burst is output.
+ *
+ * @param new_epoch: `char` `1` if the last read had a new epoch
+ * @param utc_ms: `uint32_t` UTC time of day of the last epoch
+ * @endinternal
+ */
+void M10GnssSchedulerLearn(char new_epoch, uint32_t utc_ms){
+    m10_gnss_scheduler* scheduler = m10_gnss_scheduler_instance;
+
+    if(!new_epoch)
+        return;
+
+    uint32_t phase_offset_ms = scheduler_read_tick - utc_ms;
+    uint32_t period_ms = (utc_ms + GNSS_MS_PER_DAY - scheduler->last_utc_ms) % GNSS_MS_PER_DAY;
+    char period_valid = period_ms > 0 && period_ms <= SCHEDULER_MAX_EPOCH_PERIOD_MS;
+
+    if(scheduler->observed_epochs > 0 && period_valid && (scheduler->observed_epochs == 1 || period_ms == scheduler->epoch_period_ms)){
+        scheduler->epoch_period_ms = period_ms;
+        scheduler->observed_epochs++;
+
+        // Keep the earliest arrival, since reads only ever see the data after it is output
+        if((int32_t)(phase_offset_ms - scheduler->epoch_phase_offset_ms) < 0)
+            scheduler->epoch_phase_offset_ms = phase_offset_ms;
+    }
+    else{
+        scheduler->observed_epochs = 1;
+        scheduler->epoch_phase_offset_ms = phase_offset_ms;
+    }
+
+    if(scheduler->observed_epochs <= SCHEDULER_LEARNING_EPOCHS)
+        return;
+
+    scheduler->state = SCHEDULER_LOCKED;
+    scheduler->epoch_phase_offset_ms += SCHEDULER_BURST_GUARD_MS;
+    scheduler->complete_epochs = 0;
+    scheduler->missed_epochs = 0;
+}
+
+/**
+ * @internal
+ * @brief Track the output phase while locked, correcting for the drift between the MCU clock and GNSS time.
+ *    A read that found no new epoch, or stopped in the middle of a message, came too early, so the phase is
+ * delayed by `SCHEDULER_PHASE_STEP_MS`. After `SCHEDULER_PHASE_PROBE_EPOCHS` complete epochs, it is advanced
+ * by 1 ms to probe for a lower latency. Too many missed epochs in a row send the scheduler back to learning.
+ *
+ * @param new_epoch: `char` `1` if the last read had a new epoch
+ * @param partial_read: `char` `1` if the last read stopped in the middle of a message
+ * @endinternal
+ */
+void M10GnssSchedulerTrack(char new_epoch, char partial_read){
+    m10_gnss_scheduler* scheduler = m10_gnss_scheduler_instance;
+
+    // The burst is still being output, read the rest of it a bit later
+    if(partial_read){
+        scheduler->epoch_phase_offset_ms += SCHEDULER_PHASE_STEP_MS;
+        scheduler->complete_epochs = 0;
+        return;
+    }
+
+    if(!new_epoch){
+        scheduler->epoch_phase_offset_ms += SCHEDULER_PHASE_STEP_MS;
+        scheduler->complete_epochs = 0;
+        scheduler->missed_epochs++;
+
+        if(scheduler->missed_epochs > SCHEDULER_MAX_MISSED_EPOCHS){
+            scheduler->state = SCHEDULER_LEARNING;
+            scheduler->observed_epochs = 0;
+        }
+        return;
+    }
+
+    scheduler->missed_epochs = 0;
+    scheduler->complete_epochs++;
+    if(scheduler->complete_epochs >= SCHEDULER_PHASE_PROBE_EPOCHS){
+        scheduler->epoch_phase_offset_ms--;
+        scheduler->complete_epochs = 0;
+    }
+}
+
+/**
+ * @internal
+ * @brief Evaluate the result of the last read, update the learned timing and arm the next read.
+ *
+ * @endinternal
+ */
+void M10GnssSchedulerEvaluate(void){
+    m10_gnss_scheduler* scheduler = m10_gnss_scheduler_instance;
+    utc_date_time* time_of_sample = &scheduler->m10_module->time_of_sample;
+    uint32_t utc_ms = M10GnssDriverGetTimeOfDayMs(time_of_sample);
+    char partial_read = M10GnssDriverIsParsingMessage();
+
+    // A read that stopped in the middle of a message may have left the time half updated
+    char new_epoch = !partial_read && time_of_sample->is_available && utc_ms != scheduler->last_utc_ms;
+
+    // Keep the phase offset continuous when the UTC time of day wraps around midnight
+    if(new_epoch && utc_ms < scheduler->last_utc_ms)
+        scheduler->epoch_phase_offset_ms += GNSS_MS_PER_DAY;
+
+    if(scheduler->state == SCHEDULER_LEARNING)
+        M10GnssSchedulerLearn(new_epoch, utc_ms);
+    else
+        M10GnssSchedulerTrack(new_epoch, partial_read);
+
+    if(new_epoch)
+        scheduler->last_utc_ms = utc_ms;
+
+    M10GnssSchedulerArmNextRead();
+}
+
+/**
+ * @internal
+ * @brief Initialize the scheduler and start learning the module's output phase.
+ *
+ * @param scheduler: `m10_gnss_scheduler*` Pointer to an instance of m10_gnss_scheduler
+ * @endinternal
+ */
+void M10GnssSchedulerInit(m10_gnss_scheduler* scheduler){
+    m10_gnss_scheduler_instance = scheduler;
+
+    scheduler->state = SCHEDULER_LEARNING;
+    scheduler->observed_epochs = 0;
+    scheduler->last_utc_ms = 0;
+    scheduler->read_pending = 0;
+    scheduler->evaluation_pending = 0;
+
+    // The one pulse mode stops the counter on every update, so each read is armed explicitly
+    scheduler->timer_handle->Instance->CR1 |= TIM_CR1_OPM;
+    M10GnssSchedulerArmNextRead();
+}
+
+/**
+ * @internal
+ * @brief Run the scheduler, reading the module when the timer expires.
+ *    The read is started as soon as the timer expires, but its evaluation waits until a DMA transfer (if any)
+ * is over, so the learned timing only ever sees complete reads.
+ *
+ * @endinternal
+ */
+void M10GnssSchedulerRun(void){
+    m10_gnss_scheduler* scheduler = m10_gnss_scheduler_instance;
+
+    if(scheduler->read_pending){
+        scheduler->read_pending = 0;
+        scheduler->evaluation_pending = 1;
+        scheduler_read_tick = HAL_GetTick();
+        M10GnssDriverReadData();
+    }
+
+    if(!scheduler->evaluation_pending || M10GnssDriverIsTransferInProgress())
+        return;
+
+    scheduler->evaluation_pending = 0;
+    M10GnssDriverProcessStreamBuffer();
+    M10GnssSchedulerEvaluate();
+}
+
+/**
+ * @internal
+ * @brief Signal the expiration of the scheduler's timer.
+ *
+ * @param timer_handle: `TIM_HandleTypeDef*` Handle of the timer that expired
+ * @endinternal
+ */
+void M10GnssSchedulerTimerCallback(TIM_HandleTypeDef* timer_handle){
+
+    if(m10_gnss_scheduler_instance == NULL || timer_handle != m10_gnss_scheduler_instance->timer_handle)
+        return;
+
+    m10_gnss_scheduler_instance->read_pending = 1;
+}
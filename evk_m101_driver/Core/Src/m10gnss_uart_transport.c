@@ -0,0 +1,208 @@
+#include "m10gnss_uart_transport.h"
+#include "m10gnss_driver.h"
+#include <string.h>
+
+#define UART_TRANSPORT_TIMEOUT 1000  // Timeout of the blocking writes, in ms
+
+/**
+ * @internal
+ * @brief Received bytes waiting to be read by the driver. Uses the same single producer / single consumer ring
+ * as the driver, the producer being the UART interrupt (or the DMA, with `M10_GNSS_UART_DMA_TRANSPORT`) and the
+ * consumer the driver's reads (or its parser, which reads the ring in place with `M10_GNSS_UART_DMA_TRANSPORT`).
+ * Bytes received while the ring is full are dropped and counted in `uart_transport_rx_errors`.
+ *    The DMA cannot be held back when the ring is full, and a whole lap leaves `head == tail`, which looks empty.
+ * So both sides also count their bytes since the reception started: `uart_transport_received` from the DMA
+ * events, and `uart_transport_consumed` from the moves of `tail`. Their difference is the unread data, even
+ * beyond a lap.
+ *
+ * @endinternal
+ */
+m10_gnss_stream_buffer uart_transport_ring_buffer;
+UART_HandleTypeDef* uart_transport_handle = NULL;
+uint8_t uart_transport_rx_byte;
+m10_gnss_uart_rx_errors uart_transport_rx_errors;
+char uart_transport_dma = 0;               // Set when opened by `M10_GNSS_UART_DMA_TRANSPORT`
+volatile char uart_transport_restart = 0;  // Set by the error callback, the DMA reception is restarted by the next `bytes_available`
+
+volatile uint32_t uart_transport_received = 0;  // Bytes written by the DMA, updated by its events
+uint32_t uart_transport_consumed = 0;           // Bytes consumed from the ring, up to `uart_transport_consumed_tail`
+uint16_t uart_transport_consumed_tail = 0;      // Position of `tail` when `uart_transport_consumed` was updated
+
+/**
+ * @internal
+ * @brief Clear the ring and start receiving the first byte.
+ *
+ * @endinternal
+ */
+HAL_StatusTypeDef M10GnssUartTransportOpen(m10_gnss_transport* transport){
+        uart_transport_handle = transport->handle;
+        uart_transport_ring_buffer.head = 0;
+        uart_transport_ring_buffer.tail = 0;
+        uart_transport_dma = 0;
+        memset(&uart_transport_rx_errors, 0, sizeof(uart_transport_rx_errors));
+
+        return HAL_UART_Receive_IT(uart_transport_handle, &uart_transport_rx_byte, 1);
+}
+
+/**
+ * @internal
+ * @brief Clear the ring and start the circular DMA reception over the whole ring buffer.
+ *    The DMA becomes the producer of the ring: its position is published into `head` on every half transfer,
+ * transfer complete and idle line event by `M10GnssUartTransportRxEventCallback`. There is no flow control,
+ * so the data must be parsed before the DMA laps the `tail`, i.e within `STREAM_RING_BUFFER_SIZE` byte times
+ * (~0.5 s at 38400 baud).
+ *    The error counters are kept, as this is also how the reception is restarted after an error.
+ *
+ * @endinternal
+ */
+HAL_StatusTypeDef M10GnssUartTransportOpenDma(m10_gnss_transport* transport){
+        uart_transport_handle = transport->handle;
+        uart_transport_ring_buffer.head = 0;
+        uart_transport_ring_buffer.tail = 0;
+        uart_transport_received = 0;
+        uart_transport_consumed = 0;
+        uart_transport_consumed_tail = 0;
+        uart_transport_dma = 1;
+        uart_transport_restart = 0;
+
+        return HAL_UARTEx_ReceiveToIdle_DMA(uart_transport_handle, uart_transport_ring_buffer.buffer, STREAM_RING_BUFFER_SIZE);
+}
+
+/**
+ * @internal
+ * @brief Get the number of bytes written by the DMA and not yet parsed.
+ *    The consumer count is first brought up to the current `tail`: the parser moves it by less than a lap between
+ * two calls, as there is never more than `STREAM_RING_BUFFER_SIZE - 1` bytes to parse. If the DMA got a lap (or
+ * more) ahead, the oldest unread bytes were overwritten, and the ring may hold data from both laps: the overrun is
+ * counted and everything up to the DMA position is dropped, the parser resuming on the new data (its split
+ * sentence or UBX frame is dropped too, by `M10GnssDriverRxDataLostCallback`).
+ *    After an error the HAL stops the reception, and it is restarted here (i.e from the main loop, where the
+ * ring can be safely reset) from the start of the ring buffer, dropping what was not read yet.
+ *
+ * @endinternal
+ */
+uint16_t M10GnssUartTransportBytesAvailableDma(m10_gnss_transport* transport){
+        uint16_t tail = uart_transport_ring_buffer.tail;
+        uint32_t received = uart_transport_received;
+        uint32_t unread;
+
+        uart_transport_consumed += (uint16_t)(tail - uart_transport_consumed_tail) & STREAM_RING_BUFFER_MASK;
+        uart_transport_consumed_tail = tail;
+        unread = received - uart_transport_consumed;
+
+        if(uart_transport_restart){
+            uart_transport_restart = 0;
+            uart_transport_rx_errors.dropped_bytes += unread;
+            M10GnssUartTransportOpenDma(transport);
+            M10GnssDriverRxDataLostCallback(transport->handle);
+            return 0;
+        }
+
+        // `head == tail` once the ring is full, so a full ring is already an overrun
+        if(unread >= STREAM_RING_BUFFER_SIZE){
+            uart_transport_rx_errors.overruns++;
+            uart_transport_rx_errors.dropped_bytes += unread;
+            uart_transport_consumed = received;
+            uart_transport_consumed_tail = (uint16_t)(received & STREAM_RING_BUFFER_MASK);
+            uart_transport_ring_buffer.tail = uart_transport_consumed_tail;
+            M10GnssDriverRxDataLostCallback(transport->handle);
+            return 0;
+        }
+
+        return (uint16_t)unread;
+}
+
+/**
+ * @internal
+ * @brief Get the number of received bytes not yet read.
+ *
+ * @endinternal
+ */
+uint16_t M10GnssUartTransportBytesAvailable(m10_gnss_transport* transport){
+        UNUSED(transport);
+        return (uint16_t)((uart_transport_ring_buffer.head - uart_transport_ring_buffer.tail) & STREAM_RING_BUFFER_MASK);
+}
+
+/**
+ * @internal
+ * @brief Copy received bytes out of the ring. Never blocks, the driver only asks for what `bytes_available` reported.
+ *
+ * @endinternal
+ */
+HAL_StatusTypeDef M10GnssUartTransportRead(m10_gnss_transport* transport, uint8_t* data, uint16_t data_size){
+        UNUSED(transport);
+
+        for(uint16_t i = 0; i < data_size; i++){
+            if(STREAM_BUFFER_IS_EMPTY(&uart_transport_ring_buffer))
+                return HAL_ERROR;
+
+            data[i] = STREAM_BUFFER_PEEK(&uart_transport_ring_buffer);
+            STREAM_BUFFER_ADVANCE(&uart_transport_ring_buffer);
+        }
+
+        return HAL_OK;
+}
+
+/**
+ * @internal
+ * @brief Blocking write of a message to the module.
+ *
+ * @endinternal
+ */
+HAL_StatusTypeDef M10GnssUartTransportWrite(m10_gnss_transport* transport, const uint8_t* data, uint16_t data_size){
+        return HAL_UART_Transmit(transport->handle, (uint8_t*)data, data_size, UART_TRANSPORT_TIMEOUT);
+}
+
+void M10GnssUartTransportRxCallback(UART_HandleTypeDef* uart_handle){
+
+    if(uart_handle != uart_transport_handle)
+        return;
+
+    if(STREAM_BUFFER_FREE_SPACE(&uart_transport_ring_buffer) > 0){
+        uart_transport_ring_buffer.buffer[uart_transport_ring_buffer.head] = uart_transport_rx_byte;
+        STREAM_BUFFER_COMMIT(&uart_transport_ring_buffer, 1);
+    }
+    else{
+        uart_transport_rx_errors.overruns++;
+        uart_transport_rx_errors.dropped_bytes++;
+    }
+
+    HAL_UART_Receive_IT(uart_transport_handle, &uart_transport_rx_byte, 1);
+}
+
+void M10GnssUartTransportRxEventCallback(UART_HandleTypeDef* uart_handle, uint16_t size){
+    uint16_t position = size & STREAM_RING_BUFFER_MASK;
+
+    if(uart_handle != uart_transport_handle)
+        return;
+
+    // `size` is the DMA position in the ring, STREAM_RING_BUFFER_SIZE on the transfer complete event. The half
+    // transfer and transfer complete events come at least every half lap, so the move is never a whole lap
+    uart_transport_received += (uint16_t)(position - uart_transport_ring_buffer.head) & STREAM_RING_BUFFER_MASK;
+    uart_transport_ring_buffer.head = position;
+
+    // Half transfer and transfer complete events happen in the middle of a burst, only the idle line ends one
+    if(HAL_UARTEx_GetRxEventType(uart_handle) == HAL_UART_RXEVENT_IDLE)
+        M10GnssDriverRxEventCallback(uart_handle);
+}
+
+void M10GnssUartTransportErrorCallback(UART_HandleTypeDef* uart_handle){
+
+    if(uart_handle != uart_transport_handle)
+        return;
+
+    uart_transport_rx_errors.errors++;
+
+    // Any error stops the DMA reception, the HAL resets the reception type before calling back
+    if(uart_transport_dma){
+        uart_transport_restart = 1;
+        M10GnssDriverRxEventCallback(uart_handle);
+        return;
+    }
+
+    HAL_UART_Receive_IT(uart_transport_handle, &uart_transport_rx_byte, 1);
+}
+
+const m10_gnss_uart_rx_errors* M10GnssUartTransportGetRxErrors(void){
+    return &uart_transport_rx_errors;
+}
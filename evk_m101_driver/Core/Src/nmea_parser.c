@@ -1,10 +1,23 @@
-#include <stdlib.h>
-
 #include "nmea_parser.h"
 #include "m10gnss_driver.h"
 #include "i2c.h"
 
-#define CHAR_TO_NUMERIC(char_buffer, position) (int)(((*char_buffer)[position])-48)
+#define CHAR_TO_NUMERIC(field, position) (int)(((field)->data[position])-48)
+#define IS_DIGIT(character) ((unsigned char)((character) - '0') < 10)
+#define IS_HEMISPHERE(character) ((character) == 'N' || (character) == 'S' || (character) == 'E' || (character) == 'W')
+#define LAT_LONG_MINUTES_DECIMALS 6  // Decimal digits of the minutes kept by NmeaParseLatLong
+#define DECIMAL_MAX_DIGITS 9         // Significant digits kept by NmeaParseDouble (10^9 fits an int32_t)
+
+// Decoding of the measurement representation chosen at build time (see `gnss_numeric_value`)
+#ifdef M10_GNSS_FIXED_POINT
+#define NMEA_PARSE_NUMERIC(field, value) NmeaParseDecimal((field), GNSS_NUMERIC_DECIMALS, (value))
+#else
+#define NMEA_PARSE_NUMERIC(field, value) NmeaParseDouble((field), (value))
+#endif
+
+static const uint32_t powers_of_ten[DECIMAL_MAX_DIGITS + 1] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
 
 char NmeaParserCompareOriginId(nmea_caller_id* message_origin, nmea_caller_id* table_origin){
     for (int i = 0; i < NMEA_CALLER_ID_SIZE; i++){
@@ -16,99 +29,359 @@ char NmeaParserCompareOriginId(nmea_caller_id* message_origin, nmea_caller_id* t
     return 1;
 }
 
-nmea_raw_field_metadata NmeaGetNextFieldRaw(m10_gnss_stream_buffer* stream_buffer, char (*raw_field_buffer)[NMEA_RAW_BUFFER_SIZE]){
-    char received_character = '0';
-    char finished_reading = 0;
-    char end_of_message = 0;
-    nmea_raw_field_metadata metadata = {
-                                        .raw_field_length = 0,
+nmea_field_span NmeaGetNextField(nmea_sentence* sentence){
+    unsigned char start = sentence->position;
+    unsigned char end = start;
+    unsigned char checksum = sentence->checksum;
+    nmea_field_span field = {
+                                .data = &sentence->data[start],
+                                .length = 0,
+                                .field_status = END_OF_MESSAGE
+                            };
+
+    while(end < sentence->length && sentence->data[end] != ',' && sentence->data[end] != '*'){
+        checksum ^= sentence->data[end];
+        end++;
+    }
+
+    field.length = end - start;
+    if(end < sentence->length && sentence->data[end] == ','){
+        checksum ^= ',';
+        field.field_status = (field.length == 0)?EMPTY:VALID;
+    }
+
+    sentence->checksum = checksum;
+    sentence->position = end + 1;
+    return field;
+}
+
+int NmeaParseHexDigit(char character){
+    if(character >= '0' && character <= '9')
+        return character - '0';
+
+    if(character >= 'A' && character <= 'F')
+        return character - 'A' + 10;
+
+    return -1;
+}
+
+char NmeaIsChecksumValid(nmea_sentence* sentence){
+    // Until the `*` (or the end of a sentence without checksum) is reached
+    while(sentence->position <= sentence->length && sentence->data[sentence->position - 1] != '*')
+        NmeaGetNextField(sentence);
+
+    if(sentence->position > sentence->length || sentence->length - sentence->position != 2)
+        return 0;
+
+    int high_nibble = NmeaParseHexDigit(sentence->data[sentence->position]);
+    int low_nibble = NmeaParseHexDigit(sentence->data[sentence->position + 1]);
+    if(high_nibble < 0 || low_nibble < 0)
+        return 0;
+
+    return ((high_nibble << 4) | low_nibble) == sentence->checksum;
+}
+
+unsigned char NmeaGetFieldSize(nmea_field_type type){
+    return NMEA_FIELD_SIZE(type);
+}
+
+void NmeaDecodeField(const nmea_field_span* field, const nmea_field_descriptor* descriptor, unsigned char* output){
+    void* destination = &output[descriptor->offset];
+    char is_valid = field->length > 0 && (descriptor->length == 0 || field->length == descriptor->length);
+
+    switch(descriptor->type){
+
+        case NMEA_FIELD_TIME:
+            ((utc_date_time*)destination)->is_available = is_valid && NmeaParseUtcTime((utc_date_time*)destination, field);
+            break;
+
+        case NMEA_FIELD_DATE:
+            // An empty date leaves the one received before, a malformed one makes the whole time unusable
+            if(field->length > 0 && !(is_valid && NmeaParseUtcDate((utc_date_time*)destination, field)))
+                ((utc_date_time*)destination)->is_available = 0;
+            break;
+
+        case NMEA_FIELD_LATITUDE:
+        case NMEA_FIELD_LONGITUDE:
+            ((gnss_lat_long_measurement*)destination)->is_available = is_valid && 
+                        NmeaParseLatLong((gnss_lat_long_measurement*)destination, field, (descriptor->type == NMEA_FIELD_LATITUDE)?LATITUDE:LONGITUDE);
+            break;
+
+        case NMEA_FIELD_HEMISPHERE:
+            // Without its indicator the value, decoded from the previous field without sign, cannot be used
+            if(!is_valid || !IS_HEMISPHERE(field->data[0])){
+                ((gnss_lat_long_measurement*)destination)->is_available = 0;
+                break;
+            }
+
+            ((gnss_lat_long_measurement*)destination)->indicator = field->data[0];
+            if(((gnss_lat_long_measurement*)destination)->is_available && 
+               (((gnss_lat_long_measurement*)destination)->indicator == 'S' || ((gnss_lat_long_measurement*)destination)->indicator == 'W'))
+                ((gnss_lat_long_measurement*)destination)->value = -((gnss_lat_long_measurement*)destination)->value;
+            break;
+
+        case NMEA_FIELD_NUMERIC:
+            ((gnss_numeric_measurement*)destination)->is_available = is_valid && 
+                        NMEA_PARSE_NUMERIC(field, &((gnss_numeric_measurement*)destination)->value);
+            break;
+
+        case NMEA_FIELD_INTEGER:
+            ((gnss_integer_measurement*)destination)->is_available = is_valid && 
+                        NmeaParseInteger(field, &((gnss_integer_measurement*)destination)->value);
+            break;
+
+        case NMEA_FIELD_CHAR:
+            if(is_valid)
+                *(char*)destination = field->data[0];
+            break;
+    }
+}
+
+char NmeaParseSentence(nmea_sentence* sentence, const nmea_sentence_schema* schema, void* output){
+    const nmea_field_descriptor* descriptor = schema->fields;
+    const nmea_field_descriptor* last_descriptor = &schema->fields[schema->num_fields];
+    nmea_field_span field;
+
+    for(unsigned char field_index = 0; descriptor < last_descriptor; field_index++){
+        field = NmeaGetNextField(sentence);
+
+        if(descriptor->index == field_index){
+            NmeaDecodeField(&field, descriptor, (unsigned char*)output);
+            descriptor++;
+        }
+
+        if(field.field_status == END_OF_MESSAGE)
+            break;
+    }
+
+    return NmeaIsChecksumValid(sentence);
+}
+
+/**
+ * @internal
+ * @brief Parse the 2 digit number at `position` in a field, e.g. the hours of a time or the month of a date.
+ * 
+ * @param field: `const nmea_field_span*` View of the field's characters, at least `position + 2` long
+ * @param position: `unsigned char` Position of the first digit
+ * @param min: `unsigned char` Smallest valid value
+ * @param max: `unsigned char` Largest valid value
+ * @param value: `unsigned char*` Pointer to the parsed value, left unchanged on failure
+ * @return char: `1` on success, `0` if the characters are not digits or the value is out of range
+ * @endinternal
+ */
+static inline char NmeaParseTwoDigits(const nmea_field_span* field, unsigned char position, unsigned char min, unsigned char max, unsigned char* value){
+    unsigned char number;
+
+    if(!IS_DIGIT(field->data[position]) || !IS_DIGIT(field->data[position + 1]))
+        return 0;
+
+    number = (unsigned char)(CHAR_TO_NUMERIC(field, position) * 10 + CHAR_TO_NUMERIC(field, position + 1));
+    if(number < min || number > max)
+        return 0;
+
+    *value = number;
+    return 1;
+}
+
+char NmeaParseUtcTime(utc_date_time* date_time, const nmea_field_span* field){
+    unsigned char hour, minute;
+
+    if(field->length < 6 || !NmeaParseTwoDigits(field, 0, 0, 23, &hour) || !NmeaParseTwoDigits(field, 2, 0, 59, &minute))
+        return 0;
+
+    // Seconds, with their decimals, from the 5th character on (up to 60, for a leap second)
+    nmea_field_span seconds_field = {
+                                        .data = &field->data[4],
+                                        .length = field->length - 4,
                                         .field_status = VALID
                                     };
+#ifdef M10_GNSS_FIXED_POINT
+    int32_t second;
+    if(!NmeaParseDecimal(&seconds_field, GNSS_SECOND_DECIMALS, &second) || second < 0 || second >= 61 * GNSS_SECOND_SCALE)
+        return 0;
+#else
+    double second;
+    if(!NmeaParseDouble(&seconds_field, &second) || second < 0.0 || second >= 61.0)
+        return 0;
+#endif
 
-    static int buffer_index = 0;
-    while(buffer_index < NMEA_RAW_BUFFER_SIZE){
+    date_time->hour = hour;
+    date_time->minute = minute;
+    date_time->second = second;
+    return 1;
+}
 
-        if(finished_reading){
-            // If finished reading the I2C buffer, make sure to clear the user provided buffer to avoid contamination from previous runs
-            (*raw_field_buffer)[buffer_index] = '\0';
-            buffer_index++;
-            continue;
-        }
-        
-        if(stream_buffer->buffer_index >= stream_buffer->buffer_size){
-            metadata.field_status = PARSING_EN_ROUTE;
-            return metadata;
-        }
+char NmeaParseUtcDate(utc_date_time* date_time, const nmea_field_span* field){
+    unsigned char day, month, year;
 
-        received_character = stream_buffer->buffer[stream_buffer->buffer_index];
-        stream_buffer->buffer_index++;
+    if(field->length != 6 || !NmeaParseTwoDigits(field, 0, 1, 31, &day) || !NmeaParseTwoDigits(field, 2, 1, 12, &month) ||
+       !NmeaParseTwoDigits(field, 4, 0, 99, &year))
+        return 0;
 
-        if(received_character == ',' || received_character == 0xFF){
-            finished_reading = 1;
-        }
-        else if(received_character == '\r'){
-            // continue to get the next end of message character
-            continue;
-        }
-        else if(received_character == '\n'){
-            finished_reading = 1;
-            end_of_message = 1;
-        }
-        else{
-            (*raw_field_buffer)[buffer_index] = received_character;
-            metadata.raw_field_length = buffer_index + 1;
-            buffer_index++;
+    date_time->day = day;
+    date_time->month = month;
+    date_time->year = year;
+    return 1;
+}
+
+char NmeaParseLatLong(gnss_lat_long_measurement* lat_long_measurement, const nmea_field_span* field, nmea_lat_long_parser nmea_parser_option){
+    unsigned char degree_digits = (nmea_parser_option == LATITUDE)?2:3;
+    uint32_t max_degrees = (nmea_parser_option == LATITUDE)?90:180;
+    uint32_t degrees = 0;
+    uint32_t minutes = 0;  // In 1e-6 minutes
+    unsigned char decimal_digits = 0;
+    unsigned char position = 0;
+
+    if(field->length < degree_digits + 2)
+        return 0;
+
+    for(; position < degree_digits; position++){
+        if(!IS_DIGIT(field->data[position]))
+            return 0;
+
+        degrees = degrees * 10 + CHAR_TO_NUMERIC(field, position);
+    }
+
+    for(; position < degree_digits + 2; position++){
+        if(!IS_DIGIT(field->data[position]))
+            return 0;
+
+        minutes = minutes * 10 + CHAR_TO_NUMERIC(field, position);
+    }
+
+    if(minutes >= 60)
+        return 0;
+
+    if(position < field->length && field->data[position++] != '.')
+        return 0;
+
+    for(; position < field->length; position++){
+        if(!IS_DIGIT(field->data[position]))
+            return 0;
+
+        if(decimal_digits < LAT_LONG_MINUTES_DECIMALS){
+            minutes = minutes * 10 + CHAR_TO_NUMERIC(field, position);
+            decimal_digits++;
         }
-    
     }
 
-    metadata.field_status = (end_of_message)?END_OF_MESSAGE:metadata.raw_field_length == 0;
-    buffer_index = 0;
-    return metadata;
+    for(; decimal_digits < LAT_LONG_MINUTES_DECIMALS; decimal_digits++)
+        minutes *= 10;
+
+    if(degrees > max_degrees || (degrees == max_degrees && minutes > 0))
+        return 0;
+
+    // 1e-6 minutes to 1e-7 degrees: x 10 / 60, rounded to the nearest
+    lat_long_measurement->value = (int32_t)(degrees * GNSS_LAT_LONG_SCALE + (minutes + 3) / 6);
+    return 1;
+}
+
+/**
+ * @internal
+ * @brief Append a digit to a decimal magnitude, unless it would not fit an `int32_t`.
+ * 
+ * @param magnitude: `uint32_t*` Magnitude built so far
+ * @param digit: `uint32_t` Digit to be appended, from 0 to 9
+ * @return char: `1` if the digit was appended, `0` on overflow
+ * @endinternal
+ */
+static inline char NmeaAppendDigit(uint32_t* magnitude, uint32_t digit){
+    // INT32_MAX = 2147483647: the last digit can only go up to 7 after 214748364
+    if(*magnitude > INT32_MAX / 10 || (*magnitude == INT32_MAX / 10 && digit > INT32_MAX % 10))
+        return 0;
+
+    *magnitude = *magnitude * 10 + digit;
+    return 1;
 }
 
-void NmeaParseUtcTime(utc_date_time* date_time, char (*raw_field_buffer)[NMEA_RAW_BUFFER_SIZE]){
-    date_time->hour  = CHAR_TO_NUMERIC(raw_field_buffer, 0) * 10;
-    date_time->hour += CHAR_TO_NUMERIC(raw_field_buffer, 1);
+char NmeaParseInteger(const nmea_field_span* field, int* value){
+    char is_negative = field->length > 0 && field->data[0] == '-';
+    uint32_t magnitude = 0;
 
-    date_time->minute  = CHAR_TO_NUMERIC(raw_field_buffer, 2) * 10;
-    date_time->minute += CHAR_TO_NUMERIC(raw_field_buffer, 3);
+    if(field->length <= is_negative)
+        return 0;
 
-    date_time->second  = CHAR_TO_NUMERIC(raw_field_buffer, 4) * 10.0;
-    date_time->second += CHAR_TO_NUMERIC(raw_field_buffer, 5) * 1.0;
-    date_time->second += CHAR_TO_NUMERIC(raw_field_buffer, 7) / 10.0;
-    date_time->second += CHAR_TO_NUMERIC(raw_field_buffer, 8) / 100.0;
+    for(unsigned char position = is_negative; position < field->length; position++){
+        if(!IS_DIGIT(field->data[position]) || !NmeaAppendDigit(&magnitude, CHAR_TO_NUMERIC(field, position)))
+            return 0;
+    }
+
+    *value = is_negative?-(int)magnitude:(int)magnitude;
+    return 1;
 }
 
-void NmeaParseUtcDate(utc_date_time* date_time, char (*raw_field_buffer)[NMEA_RAW_BUFFER_SIZE]){
-    date_time->day  = CHAR_TO_NUMERIC(raw_field_buffer, 0) * 10;
-    date_time->day += CHAR_TO_NUMERIC(raw_field_buffer, 1);
+char NmeaParseDecimal(const nmea_field_span* field, unsigned char decimals, int32_t* value){
+    char is_negative = field->length > 0 && field->data[0] == '-';
+    unsigned char position = is_negative;
+    unsigned char digits = 0;
+    unsigned char decimal_digits = 0;
+    char round_up = 0;
+    uint32_t magnitude = 0;
+
+    for(; position < field->length && field->data[position] != '.'; position++, digits++){
+        if(!IS_DIGIT(field->data[position]) || !NmeaAppendDigit(&magnitude, CHAR_TO_NUMERIC(field, position)))
+            return 0;
+    }
+
+    // Skip the `.`, if any
+    for(position++; position < field->length; position++, digits++){
+        if(!IS_DIGIT(field->data[position]))
+            return 0;
+
+        if(decimal_digits < decimals && !NmeaAppendDigit(&magnitude, CHAR_TO_NUMERIC(field, position)))
+            return 0;
+
+        // The first digit beyond the requested ones rounds half away from zero, the others are dropped
+        if(decimal_digits == decimals)
+            round_up = field->data[position] >= '5';
 
-    date_time->month  = CHAR_TO_NUMERIC(raw_field_buffer, 2) * 10;
-    date_time->month += CHAR_TO_NUMERIC(raw_field_buffer, 3);
+        decimal_digits++;
+    }
 
+    if(digits == 0)
+        return 0;
 
-    date_time->year  = CHAR_TO_NUMERIC(raw_field_buffer, 4) * 10;
-    date_time->year += CHAR_TO_NUMERIC(raw_field_buffer, 5);
+    for(; decimal_digits < decimals; decimal_digits++){
+        if(!NmeaAppendDigit(&magnitude, 0))
+            return 0;
+    }
+
+    if(round_up && magnitude++ == INT32_MAX)
+        return 0;
+
+    *value = is_negative?-(int32_t)magnitude:(int32_t)magnitude;
+    return 1;
 }
 
-void NmeaParseLatLong(gnss_lat_long_measurement* lat_long_measurement, char (*raw_field_buffer)[NMEA_RAW_BUFFER_SIZE], nmea_lat_long_parser nmea_parser_option){
-    int buffer_position = (nmea_parser_option==LATITUDE)? 0:1;
+char NmeaParseDouble(const nmea_field_span* field, double* value){
+    unsigned char position = field->length > 0 && field->data[0] == '-';
+    unsigned char integer_digits = 0;  // Without the leading zeros
+    unsigned char decimals = 0;
+    int32_t scaled;
 
-    lat_long_measurement->degrees = CHAR_TO_NUMERIC(raw_field_buffer, buffer_position) * 10;
-    lat_long_measurement->degrees+= CHAR_TO_NUMERIC(raw_field_buffer, ++buffer_position) * 1;
-    lat_long_measurement->degrees = (nmea_parser_option==LONGITUDE)? lat_long_measurement->degrees + CHAR_TO_NUMERIC(raw_field_buffer, 0) * 100 : lat_long_measurement->degrees;
+    for(; position < field->length && field->data[position] != '.'; position++){
+        if(integer_digits > 0 || field->data[position] != '0')
+            integer_digits++;
+    }
+
+    if(position < field->length)
+        decimals = field->length - position - 1;
+
+    // Keep the decimal digits that fit in 9 significant digits (10^9 fits an int32_t), so the single division below
+    // is exact and rounds like `atof` on the fields sent by the module, and longer fields are only rounded
+    if(integer_digits + decimals > DECIMAL_MAX_DIGITS)
+        decimals = (integer_digits < DECIMAL_MAX_DIGITS)?DECIMAL_MAX_DIGITS - integer_digits:0;
 
-    lat_long_measurement->minutes = CHAR_TO_NUMERIC(raw_field_buffer, ++buffer_position) * 10.0;
-    lat_long_measurement->minutes+= CHAR_TO_NUMERIC(raw_field_buffer, ++buffer_position) * 1.0;
-    buffer_position++; // Skip the . decimal separator
-    lat_long_measurement->minutes+= CHAR_TO_NUMERIC(raw_field_buffer, ++buffer_position) / 10.0;
-    lat_long_measurement->minutes+= CHAR_TO_NUMERIC(raw_field_buffer, ++buffer_position) / 100.0;
-    lat_long_measurement->minutes+= CHAR_TO_NUMERIC(raw_field_buffer, ++buffer_position) / 1000.0;
-    lat_long_measurement->minutes+= CHAR_TO_NUMERIC(raw_field_buffer, ++buffer_position) / 10000.0;
-    lat_long_measurement->minutes+= CHAR_TO_NUMERIC(raw_field_buffer, ++buffer_position) / 100000.0;
+    if(!NmeaParseDecimal(field, decimals, &scaled))
+        return 0;
+
+    *value = (double)scaled / powers_of_ten[decimals];
+    return 1;
 }
 
-double NmeaParseNumericFloatingPoint(char (*raw_field_buffer)[NMEA_RAW_BUFFER_SIZE]){
-    return atof((const char*)raw_field_buffer);
+double NmeaParseNumericFloatingPoint(const nmea_field_span* field){
+    double value = 0.0;
+
+    NmeaParseDouble(field, &value);
+    return value;
 }
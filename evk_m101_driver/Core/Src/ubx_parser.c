@@ -0,0 +1,307 @@
+#include "ubx_parser.h"
+
+#define UBX_PVT_VALID_DATE 0x01       // `valid`: the UTC date is valid
+#define UBX_PVT_VALID_TIME 0x02       // `valid`: the UTC time of day is valid
+#define UBX_PVT_GNSS_FIX_OK 0x01      // `flags`: valid fix, within the DOP and accuracy masks
+#define UBX_PVT_DIFF_SOLUTION 0x02    // `flags`: differential corrections were applied
+#define UBX_PVT_CARRIER_SHIFT 6       // `flags`: carrier phase range solution, 1 for float and 2 for fixed ambiguities
+#define UBX_PVT_INVALID_LLH 0x01      // `flags3`: longitude, latitude and heights are not valid
+
+#define UBX_FIX_DEAD_RECKONING 1      // `fixType` values
+#define UBX_FIX_2D 2
+#define UBX_FIX_3D 3
+#define UBX_FIX_GNSS_DEAD_RECKONING 4
+
+#define UBX_GNSS_GPS 0                // `gnssId` values of UBX-NAV-SAT
+#define UBX_GNSS_SBAS 1
+#define UBX_GNSS_GALILEO 2
+#define UBX_GNSS_BEIDOU 3
+#define UBX_GNSS_QZSS 5
+#define UBX_GNSS_GLONASS 6
+#define UBX_GNSS_NAVIC 7
+
+#define UBX_SBAS_FIRST_PRN 120        // SBAS PRNs 120 to 151 are satellites 33 to 64 in NMEA
+#define UBX_SBAS_LAST_PRN 151
+#define NMEA_SBAS_FIRST_ID 33
+#define NMEA_GLONASS_FIRST_ID 65      // GLONASS slots 1 to 32 are satellites 65 to 96 in NMEA
+
+#define UBX_MAX_GROUND_SPEED 1000000  // mm/s, above the receiver's limit (500 m/s) and low enough for the integer conversions
+
+static const int32_t powers_of_ten[] = {1, 10, 100, 1000, 10000, 100000};
+
+void UbxChecksum(const uint8_t* data, uint16_t data_size, uint8_t* checksum){
+    checksum[0] = 0;
+    checksum[1] = 0;
+
+    for (uint16_t i = 0; i < data_size; i++){
+        checksum[0] += data[i];
+        checksum[1] += checksum[0];
+    }
+}
+
+uint16_t UbxGetFrameLength(const uint8_t* header){
+    return UBX_U2(header, 4) + UBX_FRAME_OVERHEAD;
+}
+
+char UbxIsFrameValid(const ubx_frame* frame){
+    uint8_t checksum[UBX_CHECKSUM_SIZE];
+
+    if(frame->length < UBX_FRAME_OVERHEAD || frame->data[0] != UBX_SYNC_CHAR_1 || frame->data[1] != UBX_SYNC_CHAR_2 ||
+       UbxGetFrameLength(frame->data) != frame->length)
+        return 0;
+
+    UbxChecksum(&frame->data[2], frame->length - UBX_CHECKSUM_SIZE - 2, checksum);
+    return checksum[0] == frame->data[frame->length - 2] && checksum[1] == frame->data[frame->length - 1];
+}
+
+uint32_t UbxGetTimeOfWeek(const ubx_frame* frame){
+    return UBX_U4(UBX_FRAME_PAYLOAD(frame), 0);
+}
+
+/**
+ * @internal
+ * @brief Write an integer reading with `decimals` decimal digits (e.g. millimeters as meters with 3 decimals) to
+ * a numeric measurement, in the representation of the build.
+ *
+ * @param measurement: `gnss_numeric_measurement*` Measurement to be written
+ * @param value: `int32_t` Reading, in units of 10^-decimals
+ * @param decimals: `unsigned char` Decimal digits of the reading, up to 5
+ * @param unit: `char` Unit of measurement, as in the NMEA messages (`M`, `N`, `K`), `0` to leave it unchanged
+ * @param is_available: `char` Validity of the reading
+ * @endinternal
+ */
+void UbxSetNumeric(gnss_numeric_measurement* measurement, int32_t value, unsigned char decimals, char unit, char is_available){
+    measurement->is_available = is_available;
+    if(unit != 0)
+        measurement->unit_of_measurement = unit;
+
+#ifdef M10_GNSS_FIXED_POINT
+    if(decimals < GNSS_NUMERIC_DECIMALS){
+        value *= powers_of_ten[GNSS_NUMERIC_DECIMALS - decimals];
+    }
+    else if(decimals > GNSS_NUMERIC_DECIMALS){
+        int32_t divisor = powers_of_ten[decimals - GNSS_NUMERIC_DECIMALS];
+        value = (value + ((value < 0)?-divisor / 2:divisor / 2)) / divisor;
+    }
+
+    measurement->value = value;
+#else
+    measurement->value = (double)value / powers_of_ten[decimals];
+#endif
+}
+
+/**
+ * @internal
+ * @brief Get the UTC seconds of an `UBX-NAV-PVT` payload, with the nanoseconds rounded to the millisecond, as in the
+ * fixed point representation of the seconds.
+ *
+ * @param payload: `const uint8_t*` Payload of the message
+ * @return uint16_t Seconds x `GNSS_SECOND_SCALE`
+ * @endinternal
+ */
+uint16_t UbxGetSecondScaled(const uint8_t* payload){
+    int32_t nanoseconds = UBX_I4(payload, 16);
+
+    // The nanoseconds can be negative (from -1 ms to 0 around a whole second)
+    int32_t second = UBX_U1(payload, 10) * GNSS_SECOND_SCALE +
+                     (nanoseconds + ((nanoseconds < 0)?-500000:500000)) / (1000000000 / GNSS_SECOND_SCALE);
+    return (second < 0)?0:(uint16_t)second;
+}
+
+/**
+ * @internal
+ * @brief Write the UTC time and date of an `UBX-NAV-PVT` payload, with the nanoseconds added to the seconds.
+ *    The seconds are rounded to the millisecond in both representations, so the time of an epoch is the same as
+ * the one of its NMEA sentences.
+ *
+ * @param date_time: `utc_date_time*` Date and time to be written
+ * @param payload: `const uint8_t*` Payload of the message
+ * @endinternal
+ */
+void UbxSetDateTime(utc_date_time* date_time, const uint8_t* payload){
+    uint8_t valid = UBX_U1(payload, 11);
+
+    if(valid & UBX_PVT_VALID_DATE){
+        date_time->year = UBX_U2(payload, 4) % 100;
+        date_time->month = UBX_U1(payload, 6);
+        date_time->day = UBX_U1(payload, 7);
+    }
+
+    date_time->is_available = (valid & UBX_PVT_VALID_TIME) != 0;
+    if(!date_time->is_available)
+        return;
+
+    date_time->hour = UBX_U1(payload, 8);
+    date_time->minute = UBX_U1(payload, 9);
+
+#ifdef M10_GNSS_FIXED_POINT
+    date_time->second = UbxGetSecondScaled(payload);
+#else
+    date_time->second = UbxGetSecondScaled(payload) / (float)GNSS_SECOND_SCALE;
+#endif
+}
+
+char UbxGetUtcTimeOfDay(const ubx_frame* frame, uint32_t* time_of_day){
+    const uint8_t* payload = UBX_FRAME_PAYLOAD(frame);
+
+    if(UBX_FRAME_ID(frame) != UBX_ID_NAV_PVT || UBX_FRAME_PAYLOAD_SIZE(frame) != UBX_NAV_PVT_PAYLOAD_SIZE ||
+       !(UBX_U1(payload, 11) & UBX_PVT_VALID_TIME))
+        return 0;
+
+    *time_of_day = UBX_U1(payload, 8) * 3600000UL + UBX_U1(payload, 9) * 60000UL + UbxGetSecondScaled(payload);
+    return 1;
+}
+
+char UbxParseNavPvt(const ubx_frame* frame, m10_gnss* output){
+    const uint8_t* payload = UBX_FRAME_PAYLOAD(frame);
+    uint8_t fix_type, flags;
+    uint8_t carrier_solution;
+    int32_t ground_speed;
+    char is_fix_ok, is_position_valid, is_3d;
+
+    if(UBX_FRAME_PAYLOAD_SIZE(frame) != UBX_NAV_PVT_PAYLOAD_SIZE)
+        return 0;
+
+    fix_type = UBX_U1(payload, 20);
+    flags = UBX_U1(payload, 21);
+    carrier_solution = flags >> UBX_PVT_CARRIER_SHIFT;
+    is_fix_ok = (flags & UBX_PVT_GNSS_FIX_OK) != 0;
+    is_position_valid = is_fix_ok && !(UBX_U2(payload, 78) & UBX_PVT_INVALID_LLH);
+    is_3d = is_position_valid && (fix_type == UBX_FIX_3D || fix_type == UBX_FIX_GNSS_DEAD_RECKONING);
+
+    UbxSetDateTime(&output->time_of_sample, payload);
+
+    // Already in 1e-7 degrees
+    output->longitude.value = UBX_I4(payload, 24);
+    output->longitude.indicator = (output->longitude.value < 0)?'W':'E';
+    output->longitude.is_available = is_position_valid;
+    output->latitude.value = UBX_I4(payload, 28);
+    output->latitude.indicator = (output->latitude.value < 0)?'S':'N';
+    output->latitude.is_available = is_position_valid;
+
+    // Heights in mm
+    UbxSetNumeric(&output->altitude, UBX_I4(payload, 36), 3, 'M', is_3d);
+    UbxSetNumeric(&output->geoid_separation, UBX_I4(payload, 32) - UBX_I4(payload, 36), 3, 'M', is_3d);
+
+    // Ground speed in mm/s: x 3600 / 1852 for knots, x 3.6 for km/h
+    ground_speed = UBX_I4(payload, 60);
+    if(ground_speed < 0 || ground_speed > UBX_MAX_GROUND_SPEED)
+        is_fix_ok = 0;
+    else{
+        UbxSetNumeric(&output->speed_over_ground_knots, ((uint32_t)ground_speed * 3600 + 926) / 1852, 3, 'N', is_fix_ok);
+        UbxSetNumeric(&output->speed_over_ground_kmh, ((uint32_t)ground_speed * 18 + 2) / 5, 3, 'K', is_fix_ok);
+    }
+
+    // Heading of motion in 1e-5 degrees, PDOP in 0.01
+    UbxSetNumeric(&output->course_over_ground, UBX_I4(payload, 64), 5, 0, is_fix_ok);
+    UbxSetNumeric(&output->pdop, UBX_U2(payload, 76), 2, 0, fix_type != 0);
+
+    output->satellites_used.value = UBX_U1(payload, 23);
+    output->satellites_used.is_available = 1;
+
+    // NMEA equivalents: GSA navigation mode, GGA quality and RMC / GLL status and mode
+    output->fix_type.value = (fix_type == UBX_FIX_2D)?2:(fix_type == UBX_FIX_3D || fix_type == UBX_FIX_GNSS_DEAD_RECKONING)?3:1;
+    output->fix_type.is_available = 1;
+    output->fix_quality.is_available = 1;
+    output->position_status = is_fix_ok?'A':'V';
+
+    if(!is_fix_ok){
+        output->fix_quality.value = 0;
+        output->position_mode = 'N';
+    }
+    else if(fix_type == UBX_FIX_DEAD_RECKONING){
+        output->fix_quality.value = 6;
+        output->position_mode = 'E';
+    }
+    else if(carrier_solution != 0){
+        output->fix_quality.value = (carrier_solution == 2)?4:5;
+        output->position_mode = (carrier_solution == 2)?'R':'F';
+    }
+    else if(flags & UBX_PVT_DIFF_SOLUTION){
+        output->fix_quality.value = 2;
+        output->position_mode = 'D';
+    }
+    else{
+        output->fix_quality.value = 1;
+        output->position_mode = 'A';
+    }
+
+    return 1;
+}
+
+char UbxParseNavDop(const ubx_frame* frame, m10_gnss* output){
+    const uint8_t* payload = UBX_FRAME_PAYLOAD(frame);
+
+    if(UBX_FRAME_PAYLOAD_SIZE(frame) != UBX_NAV_DOP_PAYLOAD_SIZE)
+        return 0;
+
+    // In 0.01
+    UbxSetNumeric(&output->pdop, UBX_U2(payload, 6), 2, 0, 1);
+    UbxSetNumeric(&output->vdop, UBX_U2(payload, 10), 2, 0, 1);
+    UbxSetNumeric(&output->hdop, UBX_U2(payload, 12), 2, 0, 1);
+    return 1;
+}
+
+/**
+ * @internal
+ * @brief Get the constellation of an `UBX-NAV-SAT` satellite, and its ID in the NMEA numbering.
+ *
+ * @param gnss_id: `uint8_t` GNSS identifier of the satellite
+ * @param satellite_id: `uint8_t*` Satellite identifier, converted to the NMEA numbering
+ * @return gnss_constellation `NUM_GNSS_CONSTELLATIONS` if the GNSS has no table
+ * @endinternal
+ */
+gnss_constellation UbxGetConstellation(uint8_t gnss_id, uint8_t* satellite_id){
+    switch(gnss_id){
+        case UBX_GNSS_GPS: return GPS_CONSTELLATION;
+        case UBX_GNSS_GALILEO: return GALILEO_CONSTELLATION;
+        case UBX_GNSS_BEIDOU: return BEIDOU_CONSTELLATION;
+        case UBX_GNSS_QZSS: return QZSS_CONSTELLATION;
+        case UBX_GNSS_NAVIC: return NAVIC_CONSTELLATION;
+
+        case UBX_GNSS_SBAS:
+            if(*satellite_id >= UBX_SBAS_FIRST_PRN && *satellite_id <= UBX_SBAS_LAST_PRN)
+                *satellite_id = *satellite_id - UBX_SBAS_FIRST_PRN + NMEA_SBAS_FIRST_ID;
+            return GPS_CONSTELLATION;
+
+        case UBX_GNSS_GLONASS:
+            if(*satellite_id < NMEA_GLONASS_FIRST_ID)
+                *satellite_id += NMEA_GLONASS_FIRST_ID - 1;
+            return GLONASS_CONSTELLATION;
+
+        default:
+            return NUM_GNSS_CONSTELLATIONS;
+    }
+}
+
+char UbxParseNavSat(const ubx_frame* frame, gnss_constellation constellation, gnss_satellite_table* table){
+    const uint8_t* payload = UBX_FRAME_PAYLOAD(frame);
+    uint8_t num_satellites = UBX_U1(payload, 5);
+
+    if(UBX_FRAME_PAYLOAD_SIZE(frame) != UBX_NAV_SAT_HEADER_SIZE + num_satellites * UBX_NAV_SAT_SATELLITE_SIZE)
+        return 0;
+
+    table->count = 0;
+    for(const uint8_t* satellite = &payload[UBX_NAV_SAT_HEADER_SIZE];
+        satellite < &payload[UBX_FRAME_PAYLOAD_SIZE(frame)] && table->count < GNSS_SATELLITE_TABLE_SIZE;
+        satellite += UBX_NAV_SAT_SATELLITE_SIZE){
+        uint8_t satellite_id = UBX_U1(satellite, 1);
+        int8_t elevation = UBX_I1(satellite, 3);
+
+        if(UbxGetConstellation(UBX_U1(satellite, 0), &satellite_id) != constellation)
+            continue;
+
+        // The position is not known when the elevation is out of range
+        table->prn[table->count] = satellite_id;
+        table->snr[table->count] = UBX_U1(satellite, 2);
+        table->elevation[table->count] = (elevation < -90 || elevation > 90)?GNSS_ELEVATION_UNKNOWN:elevation;
+        table->azimuth[table->count] = (elevation < -90 || elevation > 90)?GNSS_AZIMUTH_UNKNOWN:(uint16_t)UBX_I2(satellite, 4);
+        table->signal_id[table->count] = 0;
+        table->count++;
+    }
+
+    // Each satellite is only reported once
+    table->num_satellites = table->count;
+    table->is_available = 1;
+    return 1;
+}
@@ -0,0 +1,19 @@
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#include <time.h>
+
+/**
+ * @brief Host benchmark helpers. The numbers are host timings, meant to compare two implementations on the same
+ * data, not cycle counts of the Cortex-M0+.
+ *
+ */
+#define BENCH_REPETITIONS 2000
+
+static inline double BenchSeconds(void){
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+#endif
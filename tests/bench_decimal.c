@@ -0,0 +1,107 @@
+#include <stdlib.h>
+#include <math.h>
+
+#include "test.h"
+#include "bench.h"
+#include "nmea_parser.h"
+
+/**
+ * Compares the decoding of the decimal fields of the recorded log (positions, speeds, course, DOPs, altitudes...)
+ * by `NmeaParseDecimal` into scaled integers and by `NmeaParseDouble` on top of it, with the `atof` call that
+ * `NmeaParseNumericFloatingPoint` used to make.
+ */
+
+#define BENCH_MAX_FIELDS 8192
+
+int test_failures = 0;
+
+static unsigned char log_data[65536];
+static nmea_field_span fields[BENCH_MAX_FIELDS];
+static volatile double sink;
+
+// Fields of digits with a decimal point, e.g. `602.1` or `2249.18330`
+static int LoadDecimalFields(size_t log_size){
+    int count = 0;
+
+    for(size_t offset = 0; offset < log_size && count < BENCH_MAX_FIELDS; offset++){
+        size_t end = offset + 1;
+        char has_point = 0;
+
+        if(log_data[offset] != ',')
+            continue;
+
+        while(end < log_size && ((log_data[end] >= '0' && log_data[end] <= '9') || log_data[end] == '.' || log_data[end] == '-')){
+            has_point |= (log_data[end] == '.');
+            end++;
+        }
+
+        if(!has_point || end == log_size || log_data[end] != ',')
+            continue;
+
+        fields[count].data = (const char*)&log_data[offset + 1];
+        fields[count].length = (unsigned char)(end - offset - 1);
+        fields[count].field_status = VALID;
+        count++;
+    }
+
+    return count;
+}
+
+static double MeasureDecimal(int count){
+    double start = BenchSeconds();
+    int32_t value;
+
+    for(int repetition = 0; repetition < BENCH_REPETITIONS; repetition++){
+        for(int i = 0; i < count; i++){
+            NmeaParseDecimal(&fields[i], 3, &value);
+            sink += value;
+        }
+    }
+
+    return (BenchSeconds() - start) * 1e9 / ((double)BENCH_REPETITIONS * count);
+}
+
+static double MeasureDouble(int count){
+    double start = BenchSeconds();
+    double value;
+
+    for(int repetition = 0; repetition < BENCH_REPETITIONS; repetition++){
+        for(int i = 0; i < count; i++){
+            NmeaParseDouble(&fields[i], &value);
+            sink += value;
+        }
+    }
+
+    return (BenchSeconds() - start) * 1e9 / ((double)BENCH_REPETITIONS * count);
+}
+
+// The fields end on a `,`, where `atof` stops
+static double MeasureAtof(int count){
+    double start = BenchSeconds();
+
+    for(int repetition = 0; repetition < BENCH_REPETITIONS; repetition++){
+        for(int i = 0; i < count; i++)
+            sink += atof(fields[i].data);
+    }
+
+    return (BenchSeconds() - start) * 1e9 / ((double)BENCH_REPETITIONS * count);
+}
+
+int main(void){
+    int count = LoadDecimalFields(TestLoadFile(TEST_LOG_PATH, log_data, sizeof(log_data)));
+    double value;
+
+    TEST_CHECK(count > 0);
+    for(int i = 0; i < count; i++){
+        double expected = atof(fields[i].data);
+
+        TEST_CHECK(NmeaParseDouble(&fields[i], &value));
+        TEST_CHECK(fabs(value - expected) <= fmax(fabs(expected), 1.0) * 5e-9);
+    }
+
+    printf("decimal fields, the %d of %s\n", count, TEST_LOG_PATH);
+    printf("  NmeaParseDecimal  %5.2f ns/field\n", MeasureDecimal(count));
+    printf("  NmeaParseDouble   %5.2f ns/field\n", MeasureDouble(count));
+    printf("  atof              %5.2f ns/field\n", MeasureAtof(count));
+    return TEST_RESULT("decimal benchmark");
+}
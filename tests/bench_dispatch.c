@@ -0,0 +1,118 @@
+#include "test.h"
+#include "bench.h"
+#include "m10gnss_driver.h"
+#include "nmea_parser.h"
+
+/**
+ * Compares the sentence type dispatch of the driver, a `switch` on the packed formatter (`M10GnssDriverGetSentenceType`),
+ * with the lookup it replaced, which walked the parsing table comparing each entry with `NmeaParserCompareOriginId`.
+ * Both classify the address field of every sentence of the recorded log, with the driver's table and with a
+ * table of twice as many entries, the extra ones before them, to show how the lookup grows with the table.
+ */
+
+#define BENCH_MAX_ADDRESSES 2048
+
+typedef struct BENCH_TABLE_ENTRY{
+    nmea_caller_id message_origin;  // Constellation + message type, with possible `*` wild card
+    m10_gnss_sentence_type sentence_type;
+} bench_table_entry;
+
+int test_failures = 0;
+
+I2C_HandleTypeDef hi2c1;
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef* handle){ UNUSED(handle); }
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef* handle){ UNUSED(handle); }
+
+m10_gnss_sentence_type M10GnssDriverGetSentenceType(const nmea_field_span* address);
+
+// Same entries and order as `NMEA_PARSING_TABLE`
+static const bench_table_entry driver_table[] = {
+    {"GNRMC", RMC_SENTENCE}, {"GNGGA", GGA_SENTENCE}, {"GNVTG", VTG_SENTENCE},
+    {"GNGSA", GSA_SENTENCE}, {"GNGLL", GLL_SENTENCE}, {"**GSV", GSV_SENTENCE}
+};
+
+static const bench_table_entry long_table[] = {
+    {"GNGNS", OTHER_SENTENCE}, {"GNZDA", OTHER_SENTENCE}, {"GNGST", OTHER_SENTENCE},
+    {"GNGBS", OTHER_SENTENCE}, {"GNGRS", OTHER_SENTENCE}, {"**TXT", OTHER_SENTENCE},
+    {"GNRMC", RMC_SENTENCE}, {"GNGGA", GGA_SENTENCE}, {"GNVTG", VTG_SENTENCE},
+    {"GNGSA", GSA_SENTENCE}, {"GNGLL", GLL_SENTENCE}, {"**GSV", GSV_SENTENCE}
+};
+
+static unsigned char log_data[65536];
+static nmea_field_span addresses[BENCH_MAX_ADDRESSES];
+static volatile uint32_t sink;
+
+static m10_gnss_sentence_type LookupSentenceType(const bench_table_entry* table, int table_size, const nmea_field_span* address){
+    nmea_caller_id message_origin = {0};
+
+    if(address->length != 5)
+        return OTHER_SENTENCE;
+
+    memcpy(message_origin, address->data, address->length);
+    for(int entry = 0; entry < table_size; entry++){
+        if(NmeaParserCompareOriginId(&message_origin, (nmea_caller_id*)&table[entry].message_origin))
+            return table[entry].sentence_type;
+    }
+
+    return OTHER_SENTENCE;
+}
+
+static int LoadAddresses(size_t log_size){
+    int count = 0;
+
+    for(size_t offset = 0; offset < log_size && count < BENCH_MAX_ADDRESSES; offset++){
+        size_t end = offset + 1;
+
+        if(log_data[offset] != '$')
+            continue;
+
+        while(end < log_size && log_data[end] != ',' && log_data[end] != '\n')
+            end++;
+
+        addresses[count].data = (const char*)&log_data[offset + 1];
+        addresses[count].length = (unsigned char)(end - offset - 1);
+        count++;
+    }
+
+    return count;
+}
+
+static double MeasureSwitch(int count){
+    double start = BenchSeconds();
+
+    for(int repetition = 0; repetition < BENCH_REPETITIONS; repetition++){
+        for(int i = 0; i < count; i++)
+            sink += M10GnssDriverGetSentenceType(&addresses[i]);
+    }
+
+    return (BenchSeconds() - start) * 1e9 / ((double)BENCH_REPETITIONS * count);
+}
+
+static double MeasureLookup(const bench_table_entry* table, int table_size, int count){
+    double start = BenchSeconds();
+
+    for(int repetition = 0; repetition < BENCH_REPETITIONS; repetition++){
+        for(int i = 0; i < count; i++)
+            sink += LookupSentenceType(table, table_size, &addresses[i]);
+    }
+
+    return (BenchSeconds() - start) * 1e9 / ((double)BENCH_REPETITIONS * count);
+}
+
+int main(void){
+    int driver_table_size = sizeof(driver_table) / sizeof(driver_table[0]);
+    int long_table_size = sizeof(long_table) / sizeof(long_table[0]);
+    int count = LoadAddresses(TestLoadFile(TEST_LOG_PATH, log_data, sizeof(log_data)));
+
+    TEST_CHECK(count > 0);
+    for(int i = 0; i < count; i++){
+        TEST_CHECK_EQUAL(M10GnssDriverGetSentenceType(&addresses[i]), LookupSentenceType(driver_table, driver_table_size, &addresses[i]));
+        TEST_CHECK_EQUAL(M10GnssDriverGetSentenceType(&addresses[i]), LookupSentenceType(long_table, long_table_size, &addresses[i]));
+    }
+
+    printf("sentence dispatch over the %d addresses of %s\n", count, TEST_LOG_PATH);
+    printf("  switch             %5.2f ns/sentence\n", MeasureSwitch(count));
+    printf("  table, %2d entries  %5.2f ns/sentence\n", driver_table_size, MeasureLookup(driver_table, driver_table_size, count));
+    printf("  table, %2d entries  %5.2f ns/sentence\n", long_table_size, MeasureLookup(long_table, long_table_size, count));
+    return TEST_RESULT("dispatch benchmark");
+}
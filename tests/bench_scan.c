@@ -0,0 +1,61 @@
+#include "test.h"
+#include "bench.h"
+#include "nmea_scan.h"
+
+/**
+ * Compares the word-at-a-time delimiter scan with the byte loop on the recorded log, for the three uses of the
+ * driver: splitting fields, framing sentences up to their `\n` and resynchronizing to the next `$`.
+ */
+
+int test_failures = 0;
+
+static unsigned char log_data[65536] __attribute__((aligned(8)));
+static volatile uint32_t sink;
+
+typedef uint16_t (*scan_function)(const unsigned char*, uint16_t, unsigned char, unsigned char, unsigned char, unsigned char);
+
+static uint16_t ScanWords(const unsigned char* data, uint16_t data_size, unsigned char a, unsigned char b, unsigned char c, unsigned char d){
+    return NmeaScanDelimiters(data, data_size, a, b, c, d);
+}
+
+static uint16_t ScanBytes(const unsigned char* data, uint16_t data_size, unsigned char a, unsigned char b, unsigned char c, unsigned char d){
+    return NmeaScanDelimitersBytewise(data, data_size, a, b, c, d);
+}
+
+// Visit every delimiter of the log, restarting the scan right after each one as the parser does
+static uint32_t ScanLog(scan_function scan, uint16_t log_size, const unsigned char delimiters[4]){
+    uint32_t found = 0;
+
+    for(uint16_t offset = 0; offset < log_size; offset++){
+        offset += scan(&log_data[offset], log_size - offset, delimiters[0], delimiters[1], delimiters[2], delimiters[3]);
+        found++;
+    }
+
+    return found;
+}
+
+static double Measure(scan_function scan, uint16_t log_size, const unsigned char delimiters[4]){
+    double start = BenchSeconds();
+
+    for(int repetition = 0; repetition < BENCH_REPETITIONS; repetition++)
+        sink += ScanLog(scan, log_size, delimiters);
+
+    return (double)BENCH_REPETITIONS * log_size / (BenchSeconds() - start) / 1e6;
+}
+
+static void Compare(const char* name, uint16_t log_size, const unsigned char delimiters[4]){
+    TEST_CHECK_EQUAL(ScanLog(ScanWords, log_size, delimiters), ScanLog(ScanBytes, log_size, delimiters));
+    printf("  %-12s byte loop %4.0f MB/s, word scan %4.0f MB/s\n", name, Measure(ScanBytes, log_size, delimiters),
+           Measure(ScanWords, log_size, delimiters));
+}
+
+int main(void){
+    uint16_t log_size = (uint16_t)TestLoadFile(TEST_LOG_PATH, log_data, sizeof(log_data));
+
+    TEST_CHECK(log_size > 0);
+    printf("delimiter scan over %u bytes of %s (%u bit words)\n", log_size, TEST_LOG_PATH, (unsigned)(8 * NMEA_SCAN_WORD_SIZE));
+    Compare("fields", log_size, (const unsigned char[]){',', '\n', '\r', 0xFF});
+    Compare("sentences", log_size, (const unsigned char[]){'\n', '\n', '\n', '\n'});
+    Compare("resync", log_size, (const unsigned char[]){'$', '$', '$', '$'});
+    return TEST_RESULT("scan benchmark");
+}
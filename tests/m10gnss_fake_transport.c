@@ -0,0 +1,196 @@
+#include <string.h>
+
+#include "m10gnss_fake_transport.h"
+#include "m10gnss_i2c_transport.h"
+
+/**
+ * @internal
+ * @brief Host side replacement of the I2C HAL calls used by the driver, emulating the module's register map
+ * (0xFD/0xFE byte count and 0xFF stream buffer) on top of an in-memory stream buffer. It takes the place of the
+ * HAL implementation in `stm32g0xx_hal_i2c.c`, so it is only linked into the host tests, where the driver is built
+ * and exercised off target.
+ *    The TX-ready pin is emulated by `HAL_GPIO_ReadPin`, which reports it as asserted whenever there are bytes
+ * left in the emulated stream buffer.
+ *    DMA transfers are not completed right away: `HAL_I2C_Mem_Read_DMA` only records the request, and the test 
+ * code decides when the "interrupt" fires through `M10GnssFakeTransportCompleteTransfer`.
+ *    Bus faults are injected on request: NACKed stream buffer reads (`M10GnssFakeTransportFailStreamReads`) and a
+ * byte count larger than the data held (`M10GnssFakeTransportOverReport`), which ends the next read in padding.
+ * 
+ * @endinternal
+ */
+typedef struct FAKE_TRANSPORT_STATE{
+    unsigned char stream_buffer[FAKE_TRANSPORT_BUFFER_SIZE];
+    uint16_t read_index;
+    uint16_t write_index;
+
+    unsigned char last_write[FAKE_TRANSPORT_WRITE_SIZE];
+    uint16_t last_write_size;
+
+    uint8_t failed_stream_reads;    // Number of blocking stream buffer reads still to be NACKed
+    uint16_t over_reported_bytes;   // Bytes reported by the next byte count read on top of the ones held
+
+    I2C_HandleTypeDef* dma_handle;
+    uint8_t* dma_destination;
+    uint16_t dma_size;
+    char dma_in_progress;
+} fake_transport_state;
+
+fake_transport_state fake_transport;
+
+void M10GnssFakeTransportLoad(const unsigned char* data, uint16_t data_size){
+
+    // Compact the buffer before appending, so already read bytes do not take space
+    memmove(fake_transport.stream_buffer, &fake_transport.stream_buffer[fake_transport.read_index], fake_transport.write_index - fake_transport.read_index);
+    fake_transport.write_index -= fake_transport.read_index;
+    fake_transport.read_index = 0;
+
+    if(data_size > FAKE_TRANSPORT_BUFFER_SIZE - fake_transport.write_index)
+        data_size = FAKE_TRANSPORT_BUFFER_SIZE - fake_transport.write_index;
+
+    memcpy(&fake_transport.stream_buffer[fake_transport.write_index], data, data_size);
+    fake_transport.write_index += data_size;
+}
+
+uint16_t M10GnssFakeTransportPendingBytes(void){
+    return fake_transport.write_index - fake_transport.read_index;
+}
+
+void M10GnssFakeTransportFailStreamReads(uint8_t count){
+    fake_transport.failed_stream_reads = count;
+}
+
+void M10GnssFakeTransportOverReport(uint16_t extra_bytes){
+    fake_transport.over_reported_bytes = extra_bytes;
+}
+
+const unsigned char* M10GnssFakeTransportLastWrite(uint16_t* data_size){
+    *data_size = fake_transport.last_write_size;
+    return fake_transport.last_write;
+}
+
+char M10GnssFakeTransportTransferInProgress(void){
+    return fake_transport.dma_in_progress;
+}
+
+/**
+ * @internal
+ * @brief Copy bytes out of the emulated stream buffer, padding with `STREAM_BUFFER_EMPTY` once it runs dry, 
+ * as the module does.
+ * 
+ * @endinternal
+ */
+void M10GnssFakeTransportReadStream(uint8_t* destination, uint16_t size){
+
+    for (uint16_t i = 0; i < size; i++){
+
+        if(fake_transport.read_index < fake_transport.write_index){
+            destination[i] = fake_transport.stream_buffer[fake_transport.read_index];
+            fake_transport.read_index++;
+        }
+        else
+            destination[i] = STREAM_BUFFER_EMPTY;
+    }
+}
+
+void M10GnssFakeTransportCompleteTransfer(void){
+
+    if(!fake_transport.dma_in_progress)
+        return;
+
+    M10GnssFakeTransportReadStream(fake_transport.dma_destination, fake_transport.dma_size);
+    fake_transport.dma_in_progress = 0;
+    HAL_I2C_MemRxCpltCallback(fake_transport.dma_handle);
+}
+
+void M10GnssFakeTransportFailTransfer(void){
+
+    if(!fake_transport.dma_in_progress)
+        return;
+
+    fake_transport.dma_in_progress = 0;
+    HAL_I2C_ErrorCallback(fake_transport.dma_handle);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout){
+    uint16_t pending_bytes = M10GnssFakeTransportPendingBytes();
+
+    UNUSED(hi2c);
+    UNUSED(DevAddress);
+    UNUSED(MemAddSize);
+    UNUSED(Timeout);
+
+    if(fake_transport.dma_in_progress)
+        return HAL_BUSY;
+
+    // The module does not acknowledge its address, nothing is read
+    if(MemAddress == STREAM_BUFFER_REGISTER && fake_transport.failed_stream_reads > 0){
+        fake_transport.failed_stream_reads--;
+        return HAL_ERROR;
+    }
+
+    if(MemAddress == AVAILABLE_BUFFER_HB){
+        pending_bytes += fake_transport.over_reported_bytes;
+        fake_transport.over_reported_bytes = 0;
+    }
+
+    for (uint16_t i = 0; i < Size; i++){
+
+        // The register address auto increments on every byte, stopping at the stream buffer register
+        switch (MemAddress){
+
+            case AVAILABLE_BUFFER_HB:
+                pData[i] = (uint8_t)(pending_bytes >> 8);
+                MemAddress++;
+                break;
+
+            case AVAILABLE_BUFFER_LB:
+                pData[i] = (uint8_t)pending_bytes;
+                MemAddress++;
+                break;
+
+            case STREAM_BUFFER_REGISTER:
+                M10GnssFakeTransportReadStream(&pData[i], 1);
+                break;
+
+            default:
+                pData[i] = 0;
+                MemAddress++;
+                break;
+        }
+    }
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t Timeout){
+    UNUSED(hi2c);
+    UNUSED(DevAddress);
+    UNUSED(Timeout);
+
+    if(fake_transport.dma_in_progress)
+        return HAL_BUSY;
+
+    fake_transport.last_write_size = (Size > FAKE_TRANSPORT_WRITE_SIZE)? FAKE_TRANSPORT_WRITE_SIZE : Size;
+    memcpy(fake_transport.last_write, pData, fake_transport.last_write_size);
+    return HAL_OK;
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin){
+    UNUSED(GPIOx);
+    UNUSED(GPIO_Pin);
+    return (M10GnssFakeTransportPendingBytes() > 0)? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size){
+    UNUSED(DevAddress);
+    UNUSED(MemAddSize);
+
+    if(fake_transport.dma_in_progress || MemAddress != STREAM_BUFFER_REGISTER)
+        return HAL_BUSY;
+
+    fake_transport.dma_handle = hi2c;
+    fake_transport.dma_destination = pData;
+    fake_transport.dma_size = Size;
+    fake_transport.dma_in_progress = 1;
+    return HAL_OK;
+}
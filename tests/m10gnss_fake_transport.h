@@ -0,0 +1,69 @@
+#ifndef __M10_GNSS_FAKE_TRANSPORT_H__
+#define __M10_GNSS_FAKE_TRANSPORT_H__
+
+#include "i2c.h"
+
+#define FAKE_TRANSPORT_BUFFER_SIZE 4096  // Max number of bytes held by the emulated module stream buffer
+#define FAKE_TRANSPORT_WRITE_SIZE 64     // Max number of bytes kept from the last write to the module
+
+/**
+ * @brief Append bytes to the emulated module's stream buffer, as if they had been output by the receiver.
+ *    Bytes that do not fit in `FAKE_TRANSPORT_BUFFER_SIZE` are dropped, as the real module would do.
+ * 
+ * @param data: `const unsigned char*` Pointer to the bytes to be appended
+ * @param data_size: `uint16_t` Number of bytes to append
+ */
+void M10GnssFakeTransportLoad(const unsigned char* data, uint16_t data_size);
+
+/**
+ * @brief Get the number of bytes still held by the emulated module's stream buffer.
+ * 
+ * @return uint16_t: Number of bytes not yet read by the driver
+ */
+uint16_t M10GnssFakeTransportPendingBytes(void);
+
+/**
+ * @brief NACK the next blocking reads of the stream buffer register: `HAL_I2C_Mem_Read` returns `HAL_ERROR` and
+ * the data stays in the emulated stream buffer.
+ * 
+ * @param count: `uint8_t` Number of reads to be NACKed
+ */
+void M10GnssFakeTransportFailStreamReads(uint8_t count);
+
+/**
+ * @brief Report more bytes than held on the next byte count read, so the following read runs past the data and
+ * ends in `STREAM_BUFFER_EMPTY` padding, as a short read does on the real module.
+ * 
+ * @param extra_bytes: `uint16_t` Bytes reported on top of the ones held
+ */
+void M10GnssFakeTransportOverReport(uint16_t extra_bytes);
+
+/**
+ * @brief Get the last frame written to the emulated module (e.g. the TX-ready configuration).
+ * 
+ * @param data_size: `uint16_t*` Pointer to hold the number of bytes written
+ * @return const unsigned char*: Pointer to the written bytes
+ */
+const unsigned char* M10GnssFakeTransportLastWrite(uint16_t* data_size);
+
+/**
+ * @brief Check if there is a DMA transfer waiting to be completed.
+ * 
+ * @return char: `1` if a transfer was started and not yet completed, `0` otherwise
+ */
+char M10GnssFakeTransportTransferInProgress(void);
+
+/**
+ * @brief Complete the DMA transfer started by `HAL_I2C_Mem_Read_DMA`, copying the data to its destination and calling 
+ * `HAL_I2C_MemRxCpltCallback`, as the DMA interrupt would do on target.
+ * 
+ */
+void M10GnssFakeTransportCompleteTransfer(void);
+
+/**
+ * @brief Abort the DMA transfer started by `HAL_I2C_Mem_Read_DMA` by calling `HAL_I2C_ErrorCallback`, no data is
+ * copied.
+ * 
+ */
+void M10GnssFakeTransportFailTransfer(void);
+#endif
@@ -0,0 +1,65 @@
+#ifndef __TEST_H__
+#define __TEST_H__
+
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief Minimal host test helpers: each check prints its location when it fails, and `TEST_RESULT` gives the
+ * exit status of the test program.
+ *
+ */
+extern int test_failures;
+
+#define TEST_CHECK(condition)                                                           \
+    do{                                                                                 \
+        if(!(condition)){                                                               \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition);        \
+            test_failures++;                                                            \
+        }                                                                               \
+    } while(0)
+
+#define TEST_CHECK_EQUAL(actual, expected)                                                              \
+    do{                                                                                                 \
+        long long test_actual = (long long)(actual), test_expected = (long long)(expected);             \
+        if(test_actual != test_expected){                                                               \
+            printf("%s:%d: %s is %lld, expected %lld\n", __FILE__, __LINE__, #actual, test_actual, test_expected); \
+            test_failures++;                                                                            \
+        }                                                                                               \
+    } while(0)
+
+#define TEST_RESULT(name) (printf("%s: %s\n", (name), test_failures ? "FAILED" : "passed"), test_failures != 0)
+
+#define TEST_LOG_PATH "../data/2024-10-21_111422_NMEA_ONLY.ubx"
+
+/**
+ * @brief Load a whole file (e.g. the recorded log) into memory.
+ *
+ * @return size_t: Number of bytes loaded, 0 if the file could not be read
+ */
+static inline size_t TestLoadFile(const char* path, unsigned char* data, size_t data_size){
+    FILE* file = fopen(path, "rb");
+    size_t size;
+
+    if(file == NULL)
+        return 0;
+
+    size = fread(data, 1, data_size, file);
+    fclose(file);
+    return size;
+}
+
+/**
+ * @brief Build a whole NMEA sentence from its body (between `$` and `*`), adding the checksum and `\r\n`.
+ *
+ * @return size_t: Number of characters written, without the terminating null
+ */
+static inline size_t TestNmeaSentence(char* sentence, size_t sentence_size, const char* body){
+    unsigned char checksum = 0;
+
+    for(const char* character = body; *character != '\0'; character++)
+        checksum ^= (unsigned char)*character;
+
+    return (size_t)snprintf(sentence, sentence_size, "$%s*%02X\r\n", body, checksum);
+}
+#endif
@@ -0,0 +1,174 @@
+#include "test.h"
+#include "m10gnss_driver.h"
+#include "m10gnss_fake_transport.h"
+#include "m10gnss_i2c_transport.h"
+
+/**
+ * Drives the driver through the fake I2C transport: DMA completion and errors, NACKed blocking reads and short
+ * reads ending in padding. Every case must end with the same readings as a clean transfer, a sentence with a
+ * broken checksum must leave the readings of the epoch untouched, and a sentence missing from an epoch must leave
+ * its measurements unavailable.
+ */
+
+int test_failures = 0;
+
+I2C_HandleTypeDef hi2c1;
+m10_gnss gnss = { .transport = M10_GNSS_I2C_TRANSPORT(&hi2c1, I2C_ADDRESS) };
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef* handle){ M10GnssDriverRxCompleteCallback(handle); }
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef* handle){ M10GnssDriverRxErrorCallback(handle); }
+
+static const char epoch[] =
+    "$GNRMC,111422.00,A,2249.18330,S,04703.91848,W,0.014,,211024,,,A,V*17\r\n"
+    "$GNGGA,111422.00,2249.18330,S,04703.91848,W,1,08,1.15,602.1,M,-5.4,M,,*54\r\n"
+    "$GNGLL,2249.18330,S,04703.91848,W,111422.00,A,A*75\r\n";
+
+static void CheckEpoch(const char* step){
+    printf("  %s\n", step);
+    TEST_CHECK_EQUAL(gnss.epoch, 1);
+    TEST_CHECK(gnss.latitude.is_available);
+    TEST_CHECK_EQUAL(gnss.latitude.value, -228197217);
+    TEST_CHECK_EQUAL(gnss.longitude.value, -470653080);
+    TEST_CHECK_EQUAL(gnss.satellites_used.value, 8);
+    TEST_CHECK_EQUAL(M10GnssDriverGetRejectCount()->rmc + M10GnssDriverGetRejectCount()->gga, 0);
+}
+
+static void Reset(m10_gnss_acquisition_mode mode){
+    memset(&gnss.latitude, 0, sizeof(gnss.latitude));
+    gnss.epoch = 0;
+    gnss.acquisition_mode = mode;
+    M10GnssDriverInit(&gnss);
+}
+
+static void TestDmaCompletion(void){
+    Reset(DMA_ACQUISITION);
+    M10GnssFakeTransportLoad((const unsigned char*)epoch, sizeof(epoch) - 1);
+
+    M10GnssDriverReadData();
+    TEST_CHECK(M10GnssFakeTransportTransferInProgress());
+    TEST_CHECK(M10GnssDriverIsTransferInProgress());
+    TEST_CHECK_EQUAL(gnss.epoch, 0);
+
+    // Chunks are chained from the completion callback until the backlog is drained
+    while(M10GnssFakeTransportTransferInProgress())
+        M10GnssFakeTransportCompleteTransfer();
+
+    TEST_CHECK(!M10GnssDriverIsTransferInProgress());
+    M10GnssDriverReadData();
+    CheckEpoch("DMA completion");
+}
+
+static void TestDmaError(void){
+    Reset(DMA_ACQUISITION);
+    M10GnssFakeTransportLoad((const unsigned char*)epoch, sizeof(epoch) - 1);
+
+    M10GnssDriverReadData();
+    M10GnssFakeTransportFailTransfer();
+    TEST_CHECK(!M10GnssDriverIsTransferInProgress());
+    TEST_CHECK_EQUAL(gnss.epoch, 0);
+    TEST_CHECK_EQUAL(M10GnssFakeTransportPendingBytes(), sizeof(epoch) - 1);
+
+    // The failed chunk was not committed, the next poll reads it again
+    M10GnssDriverReadData();
+    while(M10GnssFakeTransportTransferInProgress())
+        M10GnssFakeTransportCompleteTransfer();
+
+    M10GnssDriverReadData();
+    CheckEpoch("DMA error and retry");
+}
+
+static void TestBlockingNack(void){
+    Reset(BLOCKING_ACQUISITION);
+    M10GnssFakeTransportLoad((const unsigned char*)epoch, sizeof(epoch) - 1);
+
+    M10GnssFakeTransportFailStreamReads(1);
+    M10GnssDriverReadData();
+    TEST_CHECK_EQUAL(gnss.epoch, 0);
+    TEST_CHECK_EQUAL(M10GnssFakeTransportPendingBytes(), sizeof(epoch) - 1);
+
+    M10GnssDriverReadData();
+    CheckEpoch("NACKed blocking read and retry");
+}
+
+static void TestShortRead(void){
+    const uint16_t split = 40;
+
+    Reset(BLOCKING_ACQUISITION);
+
+    // The read runs past the first part of the RMC sentence, into padding
+    M10GnssFakeTransportLoad((const unsigned char*)epoch, split);
+    M10GnssFakeTransportOverReport(16);
+    M10GnssDriverReadData();
+    TEST_CHECK_EQUAL(M10GnssFakeTransportPendingBytes(), 0);
+    TEST_CHECK(M10GnssDriverIsParsingMessage());
+
+    M10GnssFakeTransportLoad((const unsigned char*)&epoch[split], sizeof(epoch) - 1 - split);
+    M10GnssDriverReadData();
+    CheckEpoch("short read ending in padding");
+    TEST_CHECK(!M10GnssDriverIsParsingMessage());
+}
+
+static void TestCorruptedSentence(void){
+    char next_epoch[256];
+    size_t length;
+    uint32_t rmc_rejects;
+
+    Reset(BLOCKING_ACQUISITION);
+    M10GnssFakeTransportLoad((const unsigned char*)epoch, sizeof(epoch) - 1);
+    M10GnssDriverReadData();
+    CheckEpoch("epoch before a corrupted sentence");
+    rmc_rejects = M10GnssDriverGetRejectCount()->rmc;
+
+    // The RMC opening the next epoch has another speed and a broken checksum, it must change nothing
+    length = TestNmeaSentence(next_epoch, sizeof(next_epoch), "GNRMC,111423.00,A,2249.18330,N,04703.91848,W,9.999,,211024,,,A,V");
+    next_epoch[20] = '9';
+    length += TestNmeaSentence(&next_epoch[length], sizeof(next_epoch) - length, "GNGGA,111423.00,2249.18330,S,04703.91848,W,1,09,1.15,602.1,M,-5.4,M,,");
+    length += TestNmeaSentence(&next_epoch[length], sizeof(next_epoch) - length, "GNGLL,2249.18330,S,04703.91848,W,111423.00,A,A");
+    M10GnssFakeTransportLoad((const unsigned char*)next_epoch, (uint16_t)length);
+    M10GnssDriverReadData();
+
+    TEST_CHECK_EQUAL(gnss.epoch, 2);
+    TEST_CHECK_EQUAL(M10GnssDriverGetRejectCount()->rmc, rmc_rejects + 1);
+    TEST_CHECK_EQUAL(M10GnssDriverGetSecondScaled(&gnss.time_of_sample), 23 * GNSS_SECOND_SCALE);
+    TEST_CHECK_EQUAL(gnss.time_of_sample.day, 21);
+    TEST_CHECK(!gnss.speed_over_ground_knots.is_available);
+    TEST_CHECK_EQUAL(M10GnssDriverGetNumericScaled(&gnss.speed_over_ground_knots), 14);
+    TEST_CHECK_EQUAL(gnss.satellites_used.value, 9);
+    TEST_CHECK_EQUAL(gnss.latitude.value, -228197217);
+}
+
+static void TestMissingSentence(void){
+    char next_epoch[256];
+    size_t length;
+
+    Reset(BLOCKING_ACQUISITION);
+    M10GnssFakeTransportLoad((const unsigned char*)epoch, sizeof(epoch) - 1);
+    M10GnssDriverReadData();
+    CheckEpoch("epoch before one without GGA");
+    TEST_CHECK(gnss.altitude.is_available && gnss.hdop.is_available && gnss.fix_quality.is_available);
+
+    // The next epoch has no GGA: its measurements must not be committed with the values of the previous epoch
+    length = TestNmeaSentence(next_epoch, sizeof(next_epoch), "GNRMC,111423.00,A,2249.18330,S,04703.91848,W,0.014,,211024,,,A,V");
+    length += TestNmeaSentence(&next_epoch[length], sizeof(next_epoch) - length, "GNGLL,2249.18330,S,04703.91848,W,111423.00,A,A");
+    M10GnssFakeTransportLoad((const unsigned char*)next_epoch, (uint16_t)length);
+    M10GnssDriverReadData();
+
+    TEST_CHECK_EQUAL(gnss.epoch, 2);
+    TEST_CHECK(gnss.latitude.is_available && gnss.longitude.is_available && gnss.time_of_sample.is_available);
+    TEST_CHECK(gnss.speed_over_ground_knots.is_available);
+    TEST_CHECK(!gnss.altitude.is_available);
+    TEST_CHECK(!gnss.geoid_separation.is_available);
+    TEST_CHECK(!gnss.hdop.is_available);
+    TEST_CHECK(!gnss.fix_quality.is_available);
+    TEST_CHECK(!gnss.satellites_used.is_available);
+}
+
+int main(void){
+    TestDmaCompletion();
+    TestDmaError();
+    TestBlockingNack();
+    TestShortRead();
+    TestCorruptedSentence();
+    TestMissingSentence();
+    return TEST_RESULT("fake transport");
+}
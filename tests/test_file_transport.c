@@ -0,0 +1,86 @@
+#include "test.h"
+#include "m10gnss_driver.h"
+#include "m10gnss_file_transport.h"
+
+/**
+ * Replays the recorded log through the file transport, polled as the driver reads a module: every epoch of the
+ * log must be committed, one second apart, without rejected sentences. Once closed, the transport must report no
+ * data and refuse reads, and it must be possible to open the log again.
+ */
+
+int test_failures = 0;
+
+m10_gnss gnss = { .transport = M10_GNSS_FILE_TRANSPORT(TEST_LOG_PATH) };
+
+static unsigned char log_data[65536];
+static uint32_t first_epoch_ms = GNSS_TIME_OF_DAY_UNKNOWN;
+static uint32_t last_epoch_ms = GNSS_TIME_OF_DAY_UNKNOWN;
+
+static void OnEpoch(m10_gnss* m10_module){
+    last_epoch_ms = M10GnssDriverGetTimeOfDayMs(&m10_module->time_of_sample);
+    if(first_epoch_ms == GNSS_TIME_OF_DAY_UNKNOWN)
+        first_epoch_ms = last_epoch_ms;
+}
+
+// Number of epochs in the log, one RMC sentence each
+static int CountEpochs(size_t log_size){
+    int epochs = 0;
+
+    for(size_t offset = 0; offset + 7 <= log_size; offset++){
+        if(memcmp(&log_data[offset], "$GNRMC,", 7) == 0)
+            epochs++;
+    }
+
+    return epochs;
+}
+
+static void TestReplay(size_t log_size){
+    int epochs = CountEpochs(log_size);
+    int polls = 0;
+
+    TEST_CHECK_EQUAL(gnss.transport.bytes_available(&gnss.transport), log_size);
+
+    while(gnss.transport.bytes_available(&gnss.transport) > 0 && polls < 1000){
+        M10GnssDriverReadData();
+        polls++;
+    }
+    M10GnssDriverReadData();
+
+    printf("  %d epochs in %d reads\n", epochs, polls);
+    TEST_CHECK(epochs > 0);
+    TEST_CHECK_EQUAL(gnss.epoch, epochs);
+    TEST_CHECK_EQUAL(last_epoch_ms - first_epoch_ms, (uint32_t)(epochs - 1) * 1000);
+    TEST_CHECK(gnss.latitude.is_available);
+    TEST_CHECK_EQUAL(M10GnssDriverGetRejectCount()->rmc + M10GnssDriverGetRejectCount()->gga, 0);
+    TEST_CHECK_EQUAL(M10GnssDriverGetRejectCount()->gll + M10GnssDriverGetRejectCount()->gsv, 0);
+}
+
+static void TestClose(size_t log_size){
+    uint8_t data[16];
+
+    M10GnssFileTransportClose(&gnss.transport);
+    TEST_CHECK_EQUAL(gnss.transport.bytes_available(&gnss.transport), 0);
+    TEST_CHECK_EQUAL(gnss.transport.read(&gnss.transport, data, sizeof(data)), HAL_ERROR);
+
+    // Closing twice is harmless, and the log can be replayed from the start
+    M10GnssFileTransportClose(&gnss.transport);
+    TEST_CHECK_EQUAL(gnss.transport.open(&gnss.transport), HAL_OK);
+    TEST_CHECK_EQUAL(gnss.transport.bytes_available(&gnss.transport), log_size);
+    TEST_CHECK_EQUAL(gnss.transport.read(&gnss.transport, data, sizeof(data)), HAL_OK);
+    TEST_CHECK(memcmp(data, log_data, sizeof(data)) == 0);
+
+    M10GnssFileTransportClose(&gnss.transport);
+    TEST_CHECK_EQUAL(gnss.transport.bytes_available(&gnss.transport), 0);
+}
+
+int main(void){
+    size_t log_size = TestLoadFile(TEST_LOG_PATH, log_data, sizeof(log_data));
+
+    TEST_CHECK(log_size > 0);
+    gnss.epoch_callback = OnEpoch;
+    M10GnssDriverInit(&gnss);
+
+    TestReplay(log_size);
+    TestClose(log_size);
+    return TEST_RESULT("file transport");
+}
@@ -0,0 +1,177 @@
+#include "test.h"
+#include "m10gnss_driver.h"
+#include "ubx_parser.h"
+
+/**
+ * Parses the recorded NMEA log with the UBX-NAV messages of each of its epochs (DOP, PVT, SAT and EOE, with the
+ * UTC time of its RMC) mixed in, before or after the NMEA sentences of the epoch, as a module with both outputs
+ * enabled sends them. Each epoch ends twice, on GLL and on UBX-NAV-EOE, and must still be committed exactly once.
+ */
+
+#define TEST_MAX_EPOCHS 128
+#define TEST_TIME_OF_WEEK_OFFSET 86418000  // GPS time of week at 00:00:00 UTC of the log (Monday, 18 leap seconds)
+
+int test_failures = 0;
+
+I2C_HandleTypeDef hi2c1;
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef* handle){ UNUSED(handle); }
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef* handle){ UNUSED(handle); }
+
+static unsigned char log_data[65536];
+static unsigned char stream[131072];
+static m10_gnss output;
+static m10_gnss_stream_buffer stream_buffer;
+static m10_gnss_parser parser;
+
+// UTC time of day (ms) of each committed epoch
+static uint32_t committed[TEST_MAX_EPOCHS * 2];
+static int num_committed = 0;
+
+static uint32_t TimeOfDay(const utc_date_time* date_time){
+    return date_time->hour * 3600000UL + date_time->minute * 60000UL + M10GnssDriverGetSecondScaled(date_time);
+}
+
+static void OnEpoch(m10_gnss* m10_module){
+    if(num_committed < TEST_MAX_EPOCHS * 2)
+        committed[num_committed++] = TimeOfDay(&m10_module->time_of_sample);
+}
+
+static void Put4(uint8_t* payload, int offset, uint32_t value){
+    for(int i = 0; i < 4; i++)
+        payload[offset + i] = (uint8_t)(value >> (8 * i));
+}
+
+static size_t UbxFrame(unsigned char* frame, uint8_t message_id, const uint8_t* payload, uint16_t payload_size){
+    frame[0] = UBX_SYNC_CHAR_1;
+    frame[1] = UBX_SYNC_CHAR_2;
+    frame[2] = UBX_CLASS_NAV;
+    frame[3] = message_id;
+    frame[4] = (uint8_t)payload_size;
+    frame[5] = (uint8_t)(payload_size >> 8);
+    memcpy(&frame[UBX_HEADER_SIZE], payload, payload_size);
+    UbxChecksum(&frame[2], payload_size + 4, &frame[UBX_HEADER_SIZE + payload_size]);
+    return payload_size + UBX_FRAME_OVERHEAD;
+}
+
+// UBX-NAV messages of the epoch at `time_of_day` ms, in the module's output order
+static size_t UbxEpoch(unsigned char* frames, uint32_t time_of_day){
+    uint8_t payload[UBX_NAV_PVT_PAYLOAD_SIZE] = {0};
+    uint32_t time_of_week = TEST_TIME_OF_WEEK_OFFSET + time_of_day;
+    uint32_t second = time_of_day / 1000;
+    size_t length = 0;
+
+    Put4(payload, 0, time_of_week);
+    payload[10] = 120;  // HDOP 1.2
+    length += UbxFrame(&frames[length], UBX_ID_NAV_DOP, payload, UBX_NAV_DOP_PAYLOAD_SIZE);
+
+    payload[4] = 2024 & 0xFF;
+    payload[5] = 2024 >> 8;
+    payload[6] = 10;
+    payload[7] = 21;
+    payload[8] = (uint8_t)(second / 3600);
+    payload[9] = (uint8_t)(second / 60 % 60);
+    payload[10] = (uint8_t)(second % 60);
+    payload[11] = 0x03;                  // Valid date and time
+    Put4(payload, 16, (uint32_t)-183);  // A few nanoseconds before the second, as the module reports it
+    payload[20] = 3;
+    payload[21] = 0x01;
+    payload[23] = 8;
+    Put4(payload, 24, (uint32_t)-470653080);
+    Put4(payload, 28, (uint32_t)-228197217);
+    length += UbxFrame(&frames[length], UBX_ID_NAV_PVT, payload, UBX_NAV_PVT_PAYLOAD_SIZE);
+
+    memset(payload, 0, sizeof(payload));
+    Put4(payload, 0, time_of_week);
+    payload[5] = 1;   // One satellite: GPS 7, 30 dB-Hz
+    payload[9] = 7;
+    payload[10] = 30;
+    length += UbxFrame(&frames[length], UBX_ID_NAV_SAT, payload, UBX_NAV_SAT_HEADER_SIZE + UBX_NAV_SAT_SATELLITE_SIZE);
+
+    memset(payload, 0, sizeof(payload));
+    Put4(payload, 0, time_of_week);
+    length += UbxFrame(&frames[length], UBX_ID_NAV_EOE, payload, 4);
+    return length;
+}
+
+// Time of day (ms) of the `hhmmss.ss` field after the address of an RMC sentence
+static uint32_t RmcTimeOfDay(const unsigned char* sentence){
+    const unsigned char* time = &sentence[7];
+    uint32_t hour = (time[0] - '0') * 10 + (time[1] - '0');
+    uint32_t minute = (time[2] - '0') * 10 + (time[3] - '0');
+    uint32_t second = (time[4] - '0') * 10 + (time[5] - '0');
+
+    return (hour * 3600 + minute * 60 + second) * 1000 + (time[7] - '0') * 100 + (time[8] - '0') * 10;
+}
+
+// The log with the UBX messages of each epoch before (or after) its NMEA sentences, returns the number of epochs
+static int BuildMixedStream(size_t log_size, char ubx_first, size_t* stream_size){
+    uint32_t epoch_times[TEST_MAX_EPOCHS];
+    int epochs = 0;
+    size_t length = 0;
+
+    for(size_t offset = 0; offset < log_size; offset++){
+        if(log_size - offset > 16 && memcmp(&log_data[offset], "$GNRMC,", 7) == 0 && epochs < TEST_MAX_EPOCHS){
+            epoch_times[epochs] = RmcTimeOfDay(&log_data[offset]);
+
+            if(ubx_first)
+                length += UbxEpoch(&stream[length], epoch_times[epochs]);
+            else if(epochs > 0)
+                length += UbxEpoch(&stream[length], epoch_times[epochs - 1]);
+
+            epochs++;
+        }
+        stream[length++] = log_data[offset];
+    }
+
+    if(!ubx_first && epochs > 0)
+        length += UbxEpoch(&stream[length], epoch_times[epochs - 1]);
+
+    *stream_size = length;
+    return epochs;
+}
+
+static void ParseStream(size_t stream_size, size_t chunk_size){
+    memset(&output, 0, sizeof(output));
+    output.epoch_callback = OnEpoch;
+    num_committed = 0;
+    M10GnssDriverParserInit(&parser, &stream_buffer, &output);
+
+    for(size_t offset = 0; offset < stream_size; offset += chunk_size){
+        size_t size = (stream_size - offset < chunk_size)?stream_size - offset:chunk_size;
+
+        for(size_t i = 0; i < size; i++){
+            stream_buffer.buffer[stream_buffer.head] = stream[offset + i];
+            STREAM_BUFFER_COMMIT(&stream_buffer, 1);
+        }
+        M10GnssDriverParseBuffer(&parser);
+    }
+}
+
+static void TestOneCommitPerEpoch(size_t log_size, char ubx_first){
+    const size_t chunk_sizes[] = {1, 7, 100, 1000};
+    size_t stream_size;
+    int epochs = BuildMixedStream(log_size, ubx_first, &stream_size);
+
+    printf("  %d epochs, UBX %s NMEA\n", epochs, ubx_first ? "before" : "after");
+    for(unsigned i = 0; i < sizeof(chunk_sizes) / sizeof(chunk_sizes[0]); i++){
+        ParseStream(stream_size, chunk_sizes[i]);
+
+        TEST_CHECK_EQUAL(num_committed, epochs);
+        TEST_CHECK_EQUAL(output.epoch, epochs);
+        for(int epoch = 1; epoch < num_committed; epoch++)
+            TEST_CHECK_EQUAL(committed[epoch] - committed[epoch - 1], 1000);
+
+        TEST_CHECK_EQUAL(parser.reject_count.ubx, 0);
+        TEST_CHECK(output.latitude.is_available);
+        TEST_CHECK_EQUAL(M10GnssDriverGetSecondScaled(&output.time_of_sample), committed[num_committed - 1] % 60000);
+    }
+}
+
+int main(void){
+    size_t log_size = TestLoadFile(TEST_LOG_PATH, log_data, sizeof(log_data));
+
+    TEST_CHECK(log_size > 0);
+    TestOneCommitPerEpoch(log_size, 1);
+    TestOneCommitPerEpoch(log_size, 0);
+    return TEST_RESULT("mixed stream");
+}
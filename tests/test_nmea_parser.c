@@ -0,0 +1,185 @@
+#include <stddef.h>
+#include <math.h>
+#include <stdlib.h>
+
+#include "test.h"
+#include "m10gnss_driver.h"
+#include "nmea_parser.h"
+
+/**
+ * Decodes single fields through small schemas, checking the values and the availability flags of well formed,
+ * empty and malformed fields.
+ */
+
+int test_failures = 0;
+
+// UTC seconds in ms, in both representations of `gnss_second_value`
+#ifdef M10_GNSS_FIXED_POINT
+#define TEST_SECOND_MS(date_time) ((date_time)->second)
+#else
+#define TEST_SECOND_MS(date_time) ((int)((date_time)->second * GNSS_SECOND_SCALE + 0.5f))
+#endif
+
+typedef struct TEST_OUTPUT{
+    gnss_lat_long_measurement latitude;
+    gnss_lat_long_measurement longitude;
+    utc_date_time time;
+    gnss_integer_measurement satellites;
+    gnss_numeric_measurement altitude;
+} test_output;
+
+const nmea_field_descriptor test_position_fields[] = {
+    {0, NMEA_FIELD_LATITUDE, 0, offsetof(test_output, latitude)},
+    {1, NMEA_FIELD_HEMISPHERE, 1, offsetof(test_output, latitude)},
+    {2, NMEA_FIELD_LONGITUDE, 0, offsetof(test_output, longitude)},
+    {3, NMEA_FIELD_HEMISPHERE, 1, offsetof(test_output, longitude)}
+};
+
+const nmea_field_descriptor test_time_fields[] = {
+    {0, NMEA_FIELD_TIME, 9, offsetof(test_output, time)},
+    {1, NMEA_FIELD_DATE, 6, offsetof(test_output, time)},
+    {2, NMEA_FIELD_INTEGER, 0, offsetof(test_output, satellites)}
+};
+
+const nmea_field_descriptor test_numeric_fields[] = {
+    {0, NMEA_FIELD_NUMERIC, 0, offsetof(test_output, altitude)}
+};
+
+const nmea_sentence_schema test_position_schema = NMEA_SENTENCE_SCHEMA(test_position_fields);
+const nmea_sentence_schema test_time_schema = NMEA_SENTENCE_SCHEMA(test_time_fields);
+const nmea_sentence_schema test_numeric_schema = NMEA_SENTENCE_SCHEMA(test_numeric_fields);
+
+// Parse `body` (between `$` and `*`) with `schema` into `output`, returning the checksum result
+static char ParseBody(const char* body, const nmea_sentence_schema* schema, void* output){
+    static char text[NMEA_SENTENCE_MAX_SIZE + 8];
+    nmea_sentence sentence = {
+                                .data = text,
+                                .length = (unsigned char)(TestNmeaSentence(text, sizeof(text), body) - 2),
+                                .position = 1,
+                                .checksum = 0
+                            };
+
+    NmeaGetNextField(&sentence);
+    return NmeaParseSentence(&sentence, schema, output);
+}
+
+static void TestHemisphere(void){
+    test_output output = {0};
+
+    TEST_CHECK(ParseBody("GNGLL,2249.18330,S,04703.91848,W", &test_position_schema, &output));
+    TEST_CHECK(output.latitude.is_available && output.longitude.is_available);
+    TEST_CHECK_EQUAL(output.latitude.value, -228197217);
+    TEST_CHECK_EQUAL(output.longitude.value, -470653080);
+
+    // The previous `S` and `W` must not be reused for the new values
+    TEST_CHECK(ParseBody("GNGLL,2249.18330,,04703.91848,w", &test_position_schema, &output));
+    TEST_CHECK(!output.latitude.is_available);
+    TEST_CHECK(!output.longitude.is_available);
+
+    TEST_CHECK(ParseBody("GNGLL,2249.18330,N,04703.91848,E", &test_position_schema, &output));
+    TEST_CHECK(output.latitude.is_available && output.longitude.is_available);
+    TEST_CHECK_EQUAL(output.latitude.value, 228197217);
+    TEST_CHECK_EQUAL(output.longitude.value, 470653080);
+}
+
+static void TestInteger(void){
+    test_output output = {0};
+
+    TEST_CHECK(ParseBody("GNTST,111422.00,211024,08", &test_time_schema, &output));
+    TEST_CHECK(output.satellites.is_available);
+    TEST_CHECK_EQUAL(output.satellites.value, 8);
+
+    TEST_CHECK(ParseBody("GNTST,111422.00,211024,-12", &test_time_schema, &output));
+    TEST_CHECK_EQUAL(output.satellites.value, -12);
+
+    const char* malformed[] = {"GNTST,111422.00,211024,1x", "GNTST,111422.00,211024,-", "GNTST,111422.00,211024,1.5",
+                               "GNTST,111422.00,211024,99999999999"};
+    for(unsigned i = 0; i < sizeof(malformed) / sizeof(malformed[0]); i++){
+        output.satellites.is_available = 1;
+        TEST_CHECK(ParseBody(malformed[i], &test_time_schema, &output));
+        TEST_CHECK(!output.satellites.is_available);
+    }
+}
+
+static void TestMinutes(void){
+    test_output output = {0};
+
+    TEST_CHECK(ParseBody("GNGLL,2259.99999,N,17959.99999,E", &test_position_schema, &output));
+    TEST_CHECK(output.latitude.is_available && output.longitude.is_available);
+
+    TEST_CHECK(ParseBody("GNGLL,2260.00000,N,04799.50000,E", &test_position_schema, &output));
+    TEST_CHECK(!output.latitude.is_available);
+    TEST_CHECK(!output.longitude.is_available);
+
+    TEST_CHECK(ParseBody("GNGLL,9000.00000,N,18000.00001,E", &test_position_schema, &output));
+    TEST_CHECK(output.latitude.is_available);
+    TEST_CHECK(!output.longitude.is_available);
+}
+
+static void TestTime(void){
+    test_output output = {0};
+
+    TEST_CHECK(ParseBody("GNTST,111422.50,211024,08", &test_time_schema, &output));
+    TEST_CHECK(output.time.is_available);
+    TEST_CHECK_EQUAL(output.time.hour, 11);
+    TEST_CHECK_EQUAL(output.time.minute, 14);
+    TEST_CHECK_EQUAL(TEST_SECOND_MS(&output.time), 22500);
+    TEST_CHECK_EQUAL(output.time.day, 21);
+    TEST_CHECK_EQUAL(output.time.month, 10);
+    TEST_CHECK_EQUAL(output.time.year, 24);
+
+    // Malformed seconds, hours, minutes and dates, all with the expected length
+    const char* malformed[] = {"GNTST,1114x2.00,211024,08", "GNTST,111461.00,211024,08", "GNTST,1114-2.00,211024,08",
+                               "GNTST,241422.00,211024,08", "GNTST,116022.00,211024,08", "GNTST,1a1422.00,211024,08",
+                               "GNTST,111422.00,211324,08", "GNTST,111422.00,001024,08", "GNTST,111422.00,2110x4,08"};
+    for(unsigned i = 0; i < sizeof(malformed) / sizeof(malformed[0]); i++){
+        output.time.is_available = 1;
+        TEST_CHECK(ParseBody(malformed[i], &test_time_schema, &output));
+        TEST_CHECK(!output.time.is_available);
+    }
+
+    // An empty date keeps the time
+    TEST_CHECK(ParseBody("GNTST,111423.00,,08", &test_time_schema, &output));
+    TEST_CHECK(output.time.is_available);
+    TEST_CHECK_EQUAL(TEST_SECOND_MS(&output.time), 23000);
+}
+
+static void TestLongFraction(void){
+    const char* fields[] = {"602.1", "0.014", "-5.4", "12345.123456789", "-0.000123456789012", "123456789.5", "2147483647.25"};
+    test_output output = {0};
+    double value;
+
+    for(unsigned i = 0; i < sizeof(fields) / sizeof(fields[0]); i++){
+        nmea_field_span field = {.data = fields[i], .length = (unsigned char)strlen(fields[i]), .field_status = VALID};
+        double expected = atof(fields[i]);
+
+        TEST_CHECK(NmeaParseDouble(&field, &value));
+        // 9 significant digits, or 9 decimals below 1
+        TEST_CHECK(fabs(value - expected) <= fmax(fabs(expected), 1.0) * 5e-9);
+    }
+
+    // The module's fields have few decimals, and are decoded exactly like `atof`
+    for(unsigned i = 0; i < 3; i++){
+        nmea_field_span field = {.data = fields[i], .length = (unsigned char)strlen(fields[i]), .field_status = VALID};
+
+        NmeaParseDouble(&field, &value);
+        TEST_CHECK(value == atof(fields[i]));
+    }
+
+    TEST_CHECK(ParseBody("GNTST,12345.123456789", &test_numeric_schema, &output));
+    TEST_CHECK(output.altitude.is_available);
+#ifdef M10_GNSS_FIXED_POINT
+    TEST_CHECK_EQUAL(output.altitude.value, 12345123);
+#else
+    TEST_CHECK(output.altitude.value > 12345.1234 && output.altitude.value < 12345.1236);
+#endif
+}
+
+int main(void){
+    TestHemisphere();
+    TestInteger();
+    TestMinutes();
+    TestTime();
+    TestLongFraction();
+    return TEST_RESULT("nmea parser");
+}
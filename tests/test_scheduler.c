@@ -0,0 +1,136 @@
+#include "test.h"
+#include "m10gnss_driver.h"
+#include "m10gnss_scheduler.h"
+#include "m10gnss_fake_transport.h"
+#include "m10gnss_i2c_transport.h"
+
+/**
+ * Runs the epoch-phase-locked scheduler against an emulated module that outputs one burst per second, with a
+ * millisecond HAL tick and a one pulse timer emulated on top of it. The scheduler must learn the 1 s period in
+ * both representations of the UTC seconds, lock, and then read the module about once per epoch.
+ */
+
+#define TEST_PHASE_MS 300       // Tick at which the module starts each burst, within the second
+#define TEST_BURST_MS 40        // Time taken by the module to output the whole burst
+#define TEST_EPOCHS 30
+
+int test_failures = 0;
+
+I2C_HandleTypeDef hi2c1;
+TIM_HandleTypeDef htim6;
+static TIM_TypeDef tim6;
+m10_gnss gnss = { .transport = M10_GNSS_I2C_TRANSPORT(&hi2c1, I2C_ADDRESS) };
+m10_gnss_scheduler scheduler = {
+                                    .m10_module = &gnss,
+                                    .timer_handle = &htim6
+                                };
+
+// Emulated HAL tick and one pulse timer, expiring at `timer_expiry` (or never, if negative)
+static uint32_t tick = 0;
+static int64_t timer_expiry = -1;
+
+uint32_t HAL_GetTick(void){
+    return tick;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef* handle){
+    timer_expiry = (int64_t)tick + handle->Instance->ARR + 1;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef* handle){
+    UNUSED(handle);
+    timer_expiry = -1;
+    return HAL_OK;
+}
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef* handle){ M10GnssDriverRxCompleteCallback(handle); }
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef* handle){ M10GnssDriverRxErrorCallback(handle); }
+
+// One epoch of RMC, GGA and GLL at 11:14:`second`
+static size_t BuildEpoch(char* epoch, size_t epoch_size, int second){
+    char body[80];
+    size_t length;
+
+    snprintf(body, sizeof(body), "GNRMC,1114%02d.00,A,2249.18330,S,04703.91848,W,0.014,,211024,,,A,V", second);
+    length = TestNmeaSentence(epoch, epoch_size, body);
+    snprintf(body, sizeof(body), "GNGGA,1114%02d.00,2249.18330,S,04703.91848,W,1,08,1.15,602.1,M,-5.4,M,,", second);
+    length += TestNmeaSentence(&epoch[length], epoch_size - length, body);
+    snprintf(body, sizeof(body), "GNGLL,2249.18330,S,04703.91848,W,1114%02d.00,A,A", second);
+    length += TestNmeaSentence(&epoch[length], epoch_size - length, body);
+    return length;
+}
+
+static void TestTimeOfDayMs(void){
+    utc_date_time date_time = {
+                                  .hour = 11,
+                                  .minute = 14,
+#ifdef M10_GNSS_FIXED_POINT
+                                  .second = 22500,
+#else
+                                  .second = 22.5f,
+#endif
+                                  .is_available = 1
+                              };
+
+    TEST_CHECK_EQUAL(M10GnssDriverGetTimeOfDayMs(&date_time), 11 * 3600000 + 14 * 60000 + 22500);
+
+    date_time.is_available = 0;
+    TEST_CHECK_EQUAL(M10GnssDriverGetTimeOfDayMs(&date_time), GNSS_TIME_OF_DAY_UNKNOWN);
+}
+
+static void TestLock(void){
+    char epoch[256];
+    size_t epoch_length = 0;
+    size_t sent = 0;
+    int locked_reads = 0;
+    uint32_t locked_epoch = 0;
+
+    // The burst of second `n` is output from `n * 1000 + TEST_PHASE_MS`, spread over `TEST_BURST_MS`
+    for(tick = 0; tick < TEST_EPOCHS * 1000; tick++){
+        uint32_t burst_tick = tick % 1000;
+
+        if(burst_tick == TEST_PHASE_MS){
+            epoch_length = BuildEpoch(epoch, sizeof(epoch), (int)(tick / 1000));
+            sent = 0;
+        }
+
+        if(burst_tick >= TEST_PHASE_MS && sent < epoch_length){
+            size_t burst_end = epoch_length * (burst_tick - TEST_PHASE_MS + 1) / TEST_BURST_MS;
+            burst_end = (burst_end > epoch_length)? epoch_length : burst_end;
+            M10GnssFakeTransportLoad((const unsigned char*)&epoch[sent], (uint16_t)(burst_end - sent));
+            sent = burst_end;
+        }
+
+        if(timer_expiry >= 0 && tick >= timer_expiry){
+            timer_expiry = -1;
+            M10GnssSchedulerTimerCallback(&htim6);
+            locked_reads += (locked_epoch != 0);
+        }
+
+        M10GnssSchedulerRun();
+
+        if(scheduler.state == SCHEDULER_LOCKED && locked_epoch == 0)
+            locked_epoch = gnss.epoch;
+    }
+
+    TEST_CHECK_EQUAL(scheduler.state, SCHEDULER_LOCKED);
+    TEST_CHECK_EQUAL(scheduler.epoch_period_ms, 1000);
+    TEST_CHECK(locked_epoch != 0 && locked_epoch < 10);
+    TEST_CHECK_EQUAL(gnss.epoch, TEST_EPOCHS);
+    TEST_CHECK_EQUAL(M10GnssDriverGetSecondScaled(&gnss.time_of_sample), (TEST_EPOCHS - 1) * GNSS_SECOND_SCALE);
+
+    // Once locked, the module is read about once per epoch instead of every `SCHEDULER_LEARNING_POLL_MS`
+    TEST_CHECK(locked_reads <= 2 * (TEST_EPOCHS - (int)locked_epoch));
+    printf("  locked after %u epochs, %d reads for the %u next ones\n", locked_epoch, locked_reads, TEST_EPOCHS - locked_epoch);
+}
+
+int main(void){
+    htim6.Instance = &tim6;
+    M10GnssDriverInit(&gnss);
+    M10GnssSchedulerInit(&scheduler);
+
+    TestTimeOfDayMs();
+    TestLock();
+    return TEST_RESULT("scheduler");
+}
@@ -0,0 +1,198 @@
+#include "test.h"
+#include "m10gnss_driver.h"
+#include "m10gnss_uart_transport.h"
+
+/**
+ * Drives the driver through the UART idle line DMA transport, the circular DMA being emulated: the bytes are
+ * written into the ring and the half transfer, transfer complete and idle line events are raised as the HAL does.
+ * The parser must read the ring in place, and a lap of the DMA over unread data must be reported as an overrun.
+ */
+
+int test_failures = 0;
+
+UART_HandleTypeDef huart2;
+m10_gnss gnss = {
+                    .transport = M10_GNSS_UART_DMA_TRANSPORT(&huart2),
+                    .trigger_mode = IDLE_LINE_TRIGGER
+                };
+
+// Emulated DMA channel
+static uint8_t* dma_buffer = NULL;
+static uint16_t dma_size = 0;
+static uint16_t dma_position = 0;
+static HAL_UART_RxEventTypeTypeDef rx_event_type;
+
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef* huart, uint8_t* pData, uint16_t Size){
+    UNUSED(huart);
+    dma_buffer = pData;
+    dma_size = Size;
+    dma_position = 0;
+    return HAL_OK;
+}
+
+HAL_UART_RxEventTypeTypeDef HAL_UARTEx_GetRxEventType(const UART_HandleTypeDef* huart){
+    UNUSED(huart);
+    return rx_event_type;
+}
+
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef* huart, uint8_t* pData, uint16_t Size){
+    UNUSED(huart);
+    UNUSED(pData);
+    UNUSED(Size);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef* huart, const uint8_t* pData, uint16_t Size, uint32_t Timeout){
+    UNUSED(huart);
+    UNUSED(pData);
+    UNUSED(Size);
+    UNUSED(Timeout);
+    return HAL_OK;
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin){
+    UNUSED(GPIOx);
+    UNUSED(GPIO_Pin);
+    return GPIO_PIN_RESET;
+}
+
+static void RaiseRxEvent(HAL_UART_RxEventTypeTypeDef event_type, uint16_t size){
+    rx_event_type = event_type;
+    M10GnssUartTransportRxEventCallback(&huart2, size);
+}
+
+// Receive a burst of bytes, ending with the line going idle
+static void DmaReceive(const char* data, size_t data_size){
+
+    for(size_t i = 0; i < data_size; i++){
+        dma_buffer[dma_position++] = (uint8_t)data[i];
+
+        if(dma_position == dma_size / 2)
+            RaiseRxEvent(HAL_UART_RXEVENT_HT, dma_position);
+
+        if(dma_position == dma_size){
+            RaiseRxEvent(HAL_UART_RXEVENT_TC, dma_position);
+            dma_position = 0;
+        }
+    }
+
+    RaiseRxEvent(HAL_UART_RXEVENT_IDLE, dma_position);
+}
+
+// One epoch of RMC, GGA and GLL at 11:14:`second`, 153 characters
+static size_t BuildEpoch(char* epoch, size_t epoch_size, int second){
+    char body[80];
+    size_t length;
+
+    snprintf(body, sizeof(body), "GNRMC,1114%02d.00,A,2249.18330,S,04703.91848,W,0.014,,211024,,,A,V", second);
+    length = TestNmeaSentence(epoch, epoch_size, body);
+    snprintf(body, sizeof(body), "GNGGA,1114%02d.00,2249.18330,S,04703.91848,W,1,08,1.15,602.1,M,-5.4,M,,", second);
+    length += TestNmeaSentence(&epoch[length], epoch_size - length, body);
+    snprintf(body, sizeof(body), "GNGLL,2249.18330,S,04703.91848,W,1114%02d.00,A,A", second);
+    length += TestNmeaSentence(&epoch[length], epoch_size - length, body);
+    return length;
+}
+
+static void TestParsedInPlace(void){
+    char epoch[256];
+    uint32_t epochs = gnss.epoch;
+
+    // Enough epochs to wrap around the ring a few times, each one parsed after its burst
+    for(int second = 0; second < 60; second++){
+        DmaReceive(epoch, BuildEpoch(epoch, sizeof(epoch), second));
+        M10GnssDriverReadData();
+
+        TEST_CHECK_EQUAL(gnss.epoch, epochs + second + 1);
+        TEST_CHECK_EQUAL(M10GnssDriverGetSecondScaled(&gnss.time_of_sample), second * GNSS_SECOND_SCALE);
+    }
+
+    TEST_CHECK_EQUAL(gnss.latitude.value, -228197217);
+    TEST_CHECK_EQUAL(M10GnssUartTransportGetRxErrors()->overruns, 0);
+    TEST_CHECK_EQUAL(M10GnssUartTransportGetRxErrors()->dropped_bytes, 0);
+    TEST_CHECK_EQUAL(M10GnssDriverGetRejectCount()->rmc + M10GnssDriverGetRejectCount()->gll, 0);
+}
+
+static void TestLapOverrun(void){
+    char epoch[256];
+    size_t epoch_length = BuildEpoch(epoch, sizeof(epoch), 30);
+    uint32_t epochs = gnss.epoch;
+    size_t received = 0;
+
+    // The driver is not called for more than a lap
+    while(received < STREAM_RING_BUFFER_SIZE + epoch_length){
+        DmaReceive(epoch, epoch_length);
+        received += epoch_length;
+    }
+
+    M10GnssDriverReadData();
+    TEST_CHECK_EQUAL(gnss.epoch, epochs);
+    TEST_CHECK_EQUAL(M10GnssUartTransportGetRxErrors()->overruns, 1);
+    TEST_CHECK_EQUAL(M10GnssUartTransportGetRxErrors()->dropped_bytes, received);
+
+    // The parser resumes on the data received after the overrun
+    DmaReceive(epoch, BuildEpoch(epoch, sizeof(epoch), 31));
+    M10GnssDriverReadData();
+    TEST_CHECK_EQUAL(gnss.epoch, epochs + 1);
+    TEST_CHECK_EQUAL(M10GnssDriverGetSecondScaled(&gnss.time_of_sample), 31 * GNSS_SECOND_SCALE);
+}
+
+static void TestExactLap(void){
+    char filler[STREAM_RING_BUFFER_SIZE];
+    char epoch[256];
+    uint32_t overruns = M10GnssUartTransportGetRxErrors()->overruns;
+    uint32_t epochs = gnss.epoch;
+
+    // A whole lap puts the DMA back on the tail, the ring looks empty
+    memset(filler, 'x', sizeof(filler));
+    DmaReceive(filler, sizeof(filler));
+    M10GnssDriverReadData();
+    TEST_CHECK_EQUAL(M10GnssUartTransportGetRxErrors()->overruns, overruns + 1);
+
+    DmaReceive(epoch, BuildEpoch(epoch, sizeof(epoch), 32));
+    M10GnssDriverReadData();
+    TEST_CHECK_EQUAL(gnss.epoch, epochs + 1);
+}
+
+// A frame split at the end of a burst is carried, and the rest of it is lost in a lap
+static void CheckSplitFrameDropped(const char* split, size_t split_size, int second){
+    char filler[STREAM_RING_BUFFER_SIZE];
+    char epoch[256];
+    uint32_t overruns = M10GnssUartTransportGetRxErrors()->overruns;
+    uint32_t rejected = M10GnssDriverGetRejectCount()->rmc;
+    uint32_t epochs = gnss.epoch;
+
+    DmaReceive(split, split_size);
+    M10GnssDriverReadData();
+
+    memset(filler, 'x', sizeof(filler));
+    DmaReceive(filler, sizeof(filler));
+    M10GnssDriverReadData();
+    TEST_CHECK_EQUAL(M10GnssUartTransportGetRxErrors()->overruns, overruns + 1);
+
+    // The carried start is not joined to the first bytes received after the gap
+    DmaReceive(epoch, BuildEpoch(epoch, sizeof(epoch), second));
+    M10GnssDriverReadData();
+    TEST_CHECK_EQUAL(gnss.epoch, epochs + 1);
+    TEST_CHECK(gnss.speed_over_ground_knots.is_available);
+    TEST_CHECK_EQUAL(M10GnssDriverGetSecondScaled(&gnss.time_of_sample), second * GNSS_SECOND_SCALE);
+    TEST_CHECK_EQUAL(M10GnssDriverGetRejectCount()->rmc, rejected);
+}
+
+static void TestSplitFramesDropped(void){
+    static const char split_ubx[] = {'\xb5', 'b', '\x01', '\x07', 92, 0, 0, 0};  // UBX-NAV-PVT header, and its first bytes
+    static const char split_sentence[] = "$GNRMC,111433.00,A,2249.1";
+
+    CheckSplitFrameDropped(split_ubx, sizeof(split_ubx), 34);
+    CheckSplitFrameDropped(split_sentence, sizeof(split_sentence) - 1, 35);
+}
+
+int main(void){
+    M10GnssDriverInit(&gnss);
+    TEST_CHECK(dma_buffer == ((m10_gnss_stream_buffer*)gnss.transport.stream_buffer)->buffer);
+
+    TestParsedInPlace();
+    TestLapOverrun();
+    TestExactLap();
+    TestSplitFramesDropped();
+    return TEST_RESULT("uart transport");
+}